@@ -0,0 +1,150 @@
+/*
+ * geco-ds-slot-map.h
+ *
+ *  growable slot map handing out generation tagged ids
+ */
+
+#ifndef __INCLUDE_GECO_DS_SLOT_MAP_H
+#define __INCLUDE_GECO_DS_SLOT_MAP_H
+
+#include <cstring>
+#include <vector>
+#include "geco-malloc.h"
+
+/**
+ * maps 32 bits ids to object pointers. the low SLOT_BITS of an id index a slot and the high
+ * bits are the generation of that slot, bumped every time the slot is erased, so an id still
+ * held by a timer or a callback after its object was erased never resolves to the object
+ * that reuses the slot. slots live in pages allocated when the map grows into them and never
+ * move. erased slots are reused oldest first so a generation wraps as late as possible.
+ * ids of the first use of each slot equal the slot number.
+ */
+template<class Type>
+class slot_map_t
+{
+ public:
+  static const unsigned int SLOT_BITS = 24;
+  static const unsigned int SLOT_MASK = (1u << SLOT_BITS) - 1;
+  static const unsigned int GENERATION_MASK = (1u << (32 - SLOT_BITS)) - 1;
+  /// the last slot is never used so no valid id equals INVALID_ID
+  static const unsigned int MAX_SLOTS = SLOT_MASK;
+  static const unsigned int INVALID_ID = 0xffffffff;
+  static const unsigned int PAGE_BITS = 12;
+  static const unsigned int PAGE_SLOTS = 1u << PAGE_BITS;
+
+ private:
+  struct slot_t
+  {
+    Type* value;
+    unsigned int generation;
+    unsigned int next_free;
+  };
+  std::vector<slot_t*> pages_;
+  unsigned int slots_;
+  unsigned int size_;
+  unsigned int free_head_;
+  unsigned int free_tail_;
+
+  slot_t& slot_at(unsigned int slot) const
+  {
+    return pages_[slot >> PAGE_BITS][slot & (PAGE_SLOTS - 1)];
+  }
+
+ public:
+  slot_map_t() :
+      slots_(0), size_(0), free_head_(INVALID_ID), free_tail_(INVALID_ID)
+  {
+  }
+  ~slot_map_t()
+  {
+    clear();
+  }
+
+  /// @return id of the slot now holding value, INVALID_ID when all MAX_SLOTS are in use
+  unsigned int insert(Type* value)
+  {
+    unsigned int slot;
+    if (free_head_ != INVALID_ID)
+    {
+      slot = free_head_;
+      free_head_ = slot_at(slot).next_free;
+      if (free_head_ == INVALID_ID)
+        free_tail_ = INVALID_ID;
+    }
+    else
+    {
+      if (slots_ == MAX_SLOTS)
+        return INVALID_ID;
+      if ((slots_ & (PAGE_SLOTS - 1)) == 0)
+      {
+        slot_t* page = (slot_t*) (geco_malloc_ext)(PAGE_SLOTS * sizeof(slot_t), __FILE__, __LINE__);
+        if (page == 0)
+          return INVALID_ID;
+        memset(page, 0, PAGE_SLOTS * sizeof(slot_t));
+        pages_.push_back(page);
+      }
+      slot = slots_++;
+    }
+    slot_t& s = slot_at(slot);
+    s.value = value;
+    s.next_free = INVALID_ID;
+    size_++;
+    return (s.generation << SLOT_BITS) | slot;
+  }
+
+  /// @return the object of id, NULL when id was erased or never handed out
+  Type* get(unsigned int id) const
+  {
+    unsigned int slot = id & SLOT_MASK;
+    if (slot >= slots_)
+      return 0;
+    const slot_t& s = slot_at(slot);
+    return s.generation == (id >> SLOT_BITS) ? s.value : 0;
+  }
+
+  /// @return false when id is stale
+  bool erase(unsigned int id)
+  {
+    if (get(id) == 0)
+      return false;
+    unsigned int slot = id & SLOT_MASK;
+    slot_t& s = slot_at(slot);
+    s.value = 0;
+    s.generation = (s.generation + 1) & GENERATION_MASK;
+    if (free_tail_ == INVALID_ID)
+      free_head_ = slot;
+    else
+      slot_at(free_tail_).next_free = slot;
+    free_tail_ = slot;
+    size_--;
+    return true;
+  }
+
+  /// number of slots ever used, iterate 0..slots()-1 with at_slot() to visit all objects
+  unsigned int slots() const
+  {
+    return slots_;
+  }
+  /// @return the object in slot, NULL for a free slot
+  Type* at_slot(unsigned int slot) const
+  {
+    return slot_at(slot).value;
+  }
+  /// number of objects held
+  unsigned int size() const
+  {
+    return size_;
+  }
+
+  /// drops all slots and pages, the objects themselves are not freed
+  void clear()
+  {
+    for (size_t i = 0; i < pages_.size(); i++)
+      (geco_free_ext)(pages_[i], __FILE__, __LINE__);
+    pages_.clear();
+    slots_ = size_ = 0;
+    free_head_ = free_tail_ = INVALID_ID;
+  }
+};
+
+#endif
@@ -1,71 +1,585 @@
-/*
- * Geco Gaming Company
- * All Rights Reserved.
- * Copyright (c)  2016 GECOEngine.
- *
- * GECOEngine is free software: you can redistribute it and/or modify
- * it under the terms of the GNU Lesser General Public License as published by
- * the Free Software Foundation, either version 3 of the License, or
- * (at your option) any later version.
- *
- * GECOEngine is distributed in the hope that it will be useful,
- * but WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
- * GNU Lesser General Public License for more details.
-
- * You should have received a copy of the GNU Lesser General Public License
- * along with KBEngine.  If not, see <http://www.gnu.org/licenses/>.
- *
- */
-
- // created on 02-June-2016 by Jackie Zhang
-
-#include "geco-malloc.h"
-#include "geco-ds-malloc.h"
-
-static void* _DefaultMalloc(size_t size)
-{
-    return malloc(size);
-}
-static void* _DefaultRealloc(void *p, size_t size)
-{
-    return realloc(p, size);
-}
-static void _DefaultFree(void *p, size_t size)
-{
-    free(p);
-}
-// These pointers are statically and globally defined in RakMemoryOverride.cpp
-// Change them to point to your own allocators if you want.
-// Use the functions for a DLL, or just reassign the variable if using source
-GecoMalloc geco_malloc = _DefaultMalloc;
-GecoRealloc geco_realloc = _DefaultRealloc;
-GecoFree geco_free = _DefaultFree;
-
-static geco::ds::single_client_alloc galloc;
-static void* _DefaultMalloc_Ex(size_t size, const char *file, unsigned int line)
-{
-    char* buf = (char*)galloc.allocate(size + sizeof(int));
-    *(int*)buf = size + sizeof(int);
-    return (buf + sizeof(int));
-}
-static void* _DefaultRealloc_Ex(void *p, size_t newsize, const char *file,
-    unsigned int line)
-{
-    if(p == NULL) abort();
-    int oldsize = ((int*)((char*)p - sizeof(int)))[0];
-    char* buf = (char*)galloc.reallocate(p, oldsize, newsize + sizeof(int));
-    ((int*)buf)[0] = newsize;
-    return buf + sizeof(int);
-}
-static void _DefaultFree_Ex(void *p, const char *file,unsigned int line)
-{
-    if(p == NULL) abort();
-    char* ptr = (char*)p - sizeof(int);
-    int size = *(int*)ptr;
-    galloc.deallocate(ptr, size);
-}
-/*function with ext for debug*/
-GecoMallocExt geco_malloc_ext = _DefaultMalloc_Ex;
-GecoReallocExt geco_realloc_ext = _DefaultRealloc_Ex;
+/*
+ * Geco Gaming Company
+ * All Rights Reserved.
+ * Copyright (c)  2016 GECOEngine.
+ *
+ * GECOEngine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GECOEngine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with KBEngine.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+ // created on 02-June-2016 by Jackie Zhang
+
+#include "geco-malloc.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+static void* _DefaultMalloc(size_t size)
+{
+    return malloc(size);
+}
+static void* _DefaultRealloc(void *p, size_t size)
+{
+    return realloc(p, size);
+}
+static void _DefaultFree(void *p, size_t size)
+{
+    free(p);
+}
+// These pointers are statically and globally defined in RakMemoryOverride.cpp
+// Change them to point to your own allocators if you want.
+// Use the functions for a DLL, or just reassign the variable if using source
+GecoMalloc geco_malloc = _DefaultMalloc;
+GecoRealloc geco_realloc = _DefaultRealloc;
+GecoFree geco_free = _DefaultFree;
+
+/*
+ * thread caching size class allocator behind geco_malloc_ext().
+ *
+ * every thread owns a cache of free blocks per size class, alloc and free only touch that cache.
+ * a cache refills from and flushes to a central depot of its class in batches, so the depot
+ * lock is taken once per batch, not per block. blocks do not belong to a thread, a block freed
+ * by another thread simply goes into the freeing thread's cache, when that thread exits its
+ * cache goes back to the depots.
+ *
+ * a block starts with a 16 bytes header telling its size class, user size and heap profiler
+ * site so user memory is 16 bytes aligned. classes are 16, 32, 48, 64 bytes, then multiples
+ * of the 64 bytes cache line up to 1024 bytes, then multiples of 256 bytes up to 2048 bytes,
+ * then multiples of 2048 bytes up to 8192 bytes so packet sized buffers are pooled as well.
+ * spans are cut at cache line boundaries, so blocks of 64 bytes and more never share a cache
+ * line with another block. bigger requests go to malloc() directly.
+ *
+ * spans are cut from 2MB arenas on huge pages to save tlb misses on the buffers touched per
+ * packet: MAP_HUGETLB pages when the system reserved some, otherwise a 2MB aligned mapping
+ * advised with MADV_HUGEPAGE. where neither is available spans fall back to malloc().
+ */
+#define BLOCK_HEADER_SIZE 16
+#define CACHE_LINE_SIZE 64
+#define SIZE_CLASS_NUM 26
+#define MAX_SMALL_BLOCK_SIZE 8192
+#define LARGE_BLOCK_CLASS 0xffffffff
+#define SPAN_SIZE (64 * 1024)
+#define BATCH_BYTES (8 * 1024)
+#define MIN_BATCH_SIZE 4
+#define MAX_BATCH_SIZE 64
+
+struct block_header_t
+{
+	unsigned int size_class;
+	unsigned int size; /* user size */
+	unsigned int site; /* heap profiler site + 1, 0 when not profiled */
+};
+static_assert(sizeof(block_header_t) <= BLOCK_HEADER_SIZE, "block header must fit 16 bytes");
+
+/// block size including header -> size class
+static inline unsigned int size_class_of(size_t blocksize)
+{
+	if (blocksize <= 64)
+		return (unsigned int)((blocksize + 15) >> 4) - 1; // 0..3
+	if (blocksize <= 1024)
+		return (unsigned int)((blocksize + 63) >> 6) + 2; // 4..18
+	if (blocksize <= 2048)
+		return (unsigned int)((blocksize - 1024 + 255) >> 8) + 18; // 19..22
+	return (unsigned int)((blocksize - 2048 + 2047) >> 11) + 22; // 23..25
+}
+static inline size_t class_block_size(unsigned int cls)
+{
+	if (cls < 4)
+		return (cls + 1) << 4;
+	if (cls < 19)
+		return (size_t)(cls - 2) << 6;
+	if (cls < 23)
+		return 1024 + ((size_t)(cls - 18) << 8);
+	return 2048 + ((size_t)(cls - 22) << 11);
+}
+static inline unsigned int class_batch_size(unsigned int cls)
+{
+	size_t n = BATCH_BYTES / class_block_size(cls);
+	if (n < MIN_BATCH_SIZE)
+		n = MIN_BATCH_SIZE;
+	if (n > MAX_BATCH_SIZE)
+		n = MAX_BATCH_SIZE;
+	return (unsigned int)n;
+}
+
+/// free blocks of a class, linked through the first word of a block
+struct free_list_t
+{
+	void* head;
+	unsigned int count;
+};
+static inline void* next_of(void* block)
+{
+	return *(void**)block;
+}
+/// a batch is a NULL terminated free list, batches in a depot are linked
+/// through the second word of their first block
+static inline void*& next_batch_of(void* block)
+{
+	return ((void**)block)[1];
+}
+
+struct central_depot_t
+{
+	std::mutex lock;
+	void* batches = NULL;
+	char* span_cur = NULL;
+	char* span_end = NULL;
+};
+static central_depot_t depots_[SIZE_CLASS_NUM];
+static std::atomic<size_t> span_bytes_(0);
+static std::atomic<size_t> large_bytes_(0);
+static std::atomic<size_t> depot_refills_(0);
+static std::atomic<size_t> depot_flushes_(0);
+
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+struct span_arena_t
+{
+	std::mutex lock;
+	char* cur = NULL;
+	char* end = NULL;
+};
+static span_arena_t span_arena_;
+static std::atomic<bool> use_huge_pages_(true);
+static std::atomic<size_t> hugetlb_bytes_(0);
+static std::atomic<size_t> thp_bytes_(0);
+static std::atomic<size_t> normal_page_bytes_(0);
+
+/// maps a 2MB aligned arena, NULL when the system cannot map one
+static char* map_huge_arena()
+{
+#if defined(__linux__)
+	void* p;
+#ifdef MAP_HUGETLB
+	p = mmap(NULL, HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+	if (p != MAP_FAILED)
+	{
+		hugetlb_bytes_.fetch_add(HUGE_PAGE_SIZE, std::memory_order_relaxed);
+		return (char*)p;
+	}
+#endif
+	// no hugetlbfs pages reserved, over map to get a 2MB aligned range the kernel can back
+	// with one transparent huge page
+	p = mmap(NULL, HUGE_PAGE_SIZE << 1, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (p == MAP_FAILED)
+		return NULL;
+	char* arena = (char*)(((size_t)p + HUGE_PAGE_SIZE - 1) & ~(size_t)(HUGE_PAGE_SIZE - 1));
+	if (arena != (char*)p)
+		munmap(p, arena - (char*)p);
+	munmap(arena + HUGE_PAGE_SIZE, (char*)p + HUGE_PAGE_SIZE - arena);
+#ifdef MADV_HUGEPAGE
+	if (madvise(arena, HUGE_PAGE_SIZE, MADV_HUGEPAGE) == 0)
+	{
+		thp_bytes_.fetch_add(HUGE_PAGE_SIZE, std::memory_order_relaxed);
+		return arena;
+	}
+#endif
+	normal_page_bytes_.fetch_add(HUGE_PAGE_SIZE, std::memory_order_relaxed);
+	return arena;
+#else
+	return NULL;
+#endif
+}
+
+/// @return spansize bytes aligned to the cache line, never given back
+static char* alloc_span(size_t spansize)
+{
+	if (use_huge_pages_.load(std::memory_order_relaxed) && spansize <= HUGE_PAGE_SIZE)
+	{
+		std::lock_guard<std::mutex> guard(span_arena_.lock);
+		// spans are 64KB, an arena holds a whole number of them and nothing is left over
+		if ((size_t)(span_arena_.end - span_arena_.cur) < spansize)
+		{
+			char* arena = map_huge_arena();
+			if (arena != NULL)
+			{
+				span_arena_.cur = arena;
+				span_arena_.end = arena + HUGE_PAGE_SIZE;
+			}
+		}
+		if ((size_t)(span_arena_.end - span_arena_.cur) >= spansize)
+		{
+			char* span = span_arena_.cur;
+			span_arena_.cur += spansize;
+			span_bytes_.fetch_add(spansize, std::memory_order_relaxed);
+			return span;
+		}
+	}
+	char* span = (char*)malloc(spansize + CACHE_LINE_SIZE);
+	if (span == NULL)
+		return NULL;
+	span_bytes_.fetch_add(spansize + CACHE_LINE_SIZE, std::memory_order_relaxed);
+	normal_page_bytes_.fetch_add(spansize + CACHE_LINE_SIZE, std::memory_order_relaxed);
+	return (char*)(((size_t)span + CACHE_LINE_SIZE - 1) & ~(size_t)(CACHE_LINE_SIZE - 1));
+}
+
+static void depot_push_batch(unsigned int cls, void* batch)
+{
+	central_depot_t& depot = depots_[cls];
+	std::lock_guard<std::mutex> guard(depot.lock);
+	next_batch_of(batch) = depot.batches;
+	depot.batches = batch;
+	depot_flushes_.fetch_add(1, std::memory_order_relaxed);
+}
+
+/// takes a batch from the depot, cuts a new one from the span when the depot is empty
+static void* depot_pop_batch(unsigned int cls)
+{
+	central_depot_t& depot = depots_[cls];
+	std::lock_guard<std::mutex> guard(depot.lock);
+	depot_refills_.fetch_add(1, std::memory_order_relaxed);
+	void* batch = depot.batches;
+	if (batch != NULL)
+	{
+		depot.batches = next_batch_of(batch);
+		return batch;
+	}
+
+	size_t blocksize = class_block_size(cls);
+	unsigned int batchsize = class_batch_size(cls);
+	if ((size_t)(depot.span_end - depot.span_cur) < blocksize * batchsize)
+	{
+		// spans are never given back, the same as the free lists of default_alloc
+		size_t spansize = blocksize * batchsize > SPAN_SIZE ? blocksize * batchsize : SPAN_SIZE;
+		char* span = alloc_span(spansize);
+		if (span == NULL)
+			return NULL;
+		depot.span_cur = span;
+		depot.span_end = span + spansize;
+	}
+	batch = depot.span_cur;
+	char* block = depot.span_cur;
+	for (unsigned int i = 1; i < batchsize; i++, block += blocksize)
+		*(void**)block = block + blocksize;
+	*(void**)block = NULL;
+	depot.span_cur = block + blocksize;
+	return batch;
+}
+
+struct thread_cache_t
+{
+	free_list_t lists[SIZE_CLASS_NUM];
+	size_t allocs;
+	bool exited; // blocks freed by later thread_local destructors go straight to the depots
+	~thread_cache_t()
+	{
+		for (unsigned int cls = 0; cls < SIZE_CLASS_NUM; cls++)
+			flush(cls, lists[cls].count);
+		exited = true;
+	}
+	/// gives the first n blocks of a class back to its depot as one batch
+	void flush(unsigned int cls, unsigned int n)
+	{
+		free_list_t& list = lists[cls];
+		if (n == 0 || list.head == NULL)
+			return;
+		void* batch = list.head;
+		void* last = batch;
+		unsigned int taken = 1;
+		for (; taken < n && next_of(last) != NULL; taken++)
+			last = next_of(last);
+		list.head = next_of(last);
+		list.count -= taken;
+		*(void**)last = NULL;
+		depot_push_batch(cls, batch);
+	}
+};
+static thread_local thread_cache_t tcache_;
+
+static inline void* alloc_block(size_t size)
+{
+	block_header_t* hdr;
+	// a zero byte request still gets a usable byte, never a bare header
+	size_t blocksize = (size == 0 ? 1 : size) + BLOCK_HEADER_SIZE;
+	if (blocksize > MAX_SMALL_BLOCK_SIZE)
+	{
+		hdr = (block_header_t*)malloc(blocksize);
+		if (hdr == NULL)
+			return NULL;
+		large_bytes_.fetch_add(size, std::memory_order_relaxed);
+		tcache_.allocs++;
+		hdr->size_class = LARGE_BLOCK_CLASS;
+		hdr->size = (unsigned int)size;
+		hdr->site = 0;
+		return (char*)hdr + BLOCK_HEADER_SIZE;
+	}
+
+	unsigned int cls = size_class_of(blocksize);
+	free_list_t& list = tcache_.lists[cls];
+	tcache_.allocs++;
+	if (list.head == NULL)
+	{
+		void* batch = depot_pop_batch(cls);
+		if (batch == NULL)
+			return NULL;
+		unsigned int n = 1;
+		for (void* block = batch; next_of(block) != NULL; block = next_of(block))
+			n++;
+		list.head = batch;
+		list.count = n;
+	}
+	hdr = (block_header_t*)list.head;
+	list.head = next_of(hdr);
+	list.count--;
+	hdr->size_class = cls;
+	hdr->size = (unsigned int)size;
+	hdr->site = 0;
+	return (char*)hdr + BLOCK_HEADER_SIZE;
+}
+
+/*
+ * heap profiler. sites live in a fixed open addressing table keyed by a hash of the file
+ * pointer and line, a site is claimed with one cas the first time it allocates and never
+ * given back. the table index is kept in the block header so a free finds its site without
+ * hashing. counters are relaxed atomics, sites beyond the table share the last entry.
+ */
+#define HEAP_PROFILER_SITES 4096 // must be power of 2
+
+struct heap_site_t
+{
+	std::atomic<uint64_t> key;
+	std::atomic<const char*> file;
+	std::atomic<unsigned int> line;
+	std::atomic<size_t> live_bytes;
+	std::atomic<size_t> live_blocks;
+	std::atomic<size_t> peak_bytes;
+	std::atomic<size_t> allocs;
+	std::atomic<size_t> alloc_bytes;
+};
+static heap_site_t heap_sites_[HEAP_PROFILER_SITES + 1];
+static std::atomic<bool> heap_profiling_(false);
+
+static unsigned int heap_site_of(const char* file, unsigned int line)
+{
+	uint64_t key = ((uint64_t)(size_t)file * 0x9E3779B97F4A7C15ULL) ^ line;
+	if (key == 0)
+		key = 1;
+	unsigned int idx = (unsigned int)(key ^ (key >> 32)) & (HEAP_PROFILER_SITES - 1);
+	for (unsigned int probe = 0; probe < HEAP_PROFILER_SITES; probe++)
+	{
+		heap_site_t& site = heap_sites_[idx];
+		uint64_t cur = site.key.load(std::memory_order_acquire);
+		if (cur == key)
+			return idx;
+		if (cur == 0)
+		{
+			if (site.key.compare_exchange_strong(cur, key, std::memory_order_acq_rel))
+			{
+				site.file.store(file, std::memory_order_relaxed);
+				site.line.store(line, std::memory_order_relaxed);
+				return idx;
+			}
+			if (cur == key)
+				return idx;
+		}
+		idx = (idx + 1) & (HEAP_PROFILER_SITES - 1);
+	}
+	return HEAP_PROFILER_SITES;
+}
+static void heap_site_add(heap_site_t& site, size_t size)
+{
+	size_t live = site.live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+	size_t peak = site.peak_bytes.load(std::memory_order_relaxed);
+	while (live > peak && !site.peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+		;
+}
+static inline void* profile_block(void* p, size_t size, const char* file, unsigned int line)
+{
+	if (p == NULL || !heap_profiling_.load(std::memory_order_relaxed))
+		return p;
+	block_header_t* hdr = (block_header_t*)((char*)p - BLOCK_HEADER_SIZE);
+	unsigned int idx = heap_site_of(file, line);
+	heap_site_t& site = heap_sites_[idx];
+	site.allocs.fetch_add(1, std::memory_order_relaxed);
+	site.alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+	site.live_blocks.fetch_add(1, std::memory_order_relaxed);
+	heap_site_add(site, size);
+	hdr->site = idx + 1;
+	return p;
+}
+
+static inline void free_block(void* p)
+{
+	block_header_t* hdr = (block_header_t*)((char*)p - BLOCK_HEADER_SIZE);
+	if (hdr->site != 0)
+	{
+		heap_site_t& site = heap_sites_[hdr->site - 1];
+		site.live_bytes.fetch_sub(hdr->size, std::memory_order_relaxed);
+		site.live_blocks.fetch_sub(1, std::memory_order_relaxed);
+	}
+	unsigned int cls = hdr->size_class;
+	if (cls == LARGE_BLOCK_CLASS)
+	{
+		large_bytes_.fetch_sub(hdr->size, std::memory_order_relaxed);
+		free(hdr);
+		return;
+	}
+	assert(cls < SIZE_CLASS_NUM);
+	if (tcache_.exited)
+	{
+		*(void**)hdr = NULL;
+		depot_push_batch(cls, hdr);
+		return;
+	}
+	free_list_t& list = tcache_.lists[cls];
+	*(void**)hdr = list.head;
+	list.head = hdr;
+	// keep at most two batches per class, a producer thread handing blocks to a
+	// consumer thread would otherwise pile them up in the consumer's cache
+	unsigned int batchsize = class_batch_size(cls);
+	if (++list.count > (batchsize << 1))
+		tcache_.flush(cls, batchsize);
+}
+
+static inline size_t usable_size(void* p)
+{
+	block_header_t* hdr = (block_header_t*)((char*)p - BLOCK_HEADER_SIZE);
+	if (hdr->size_class == LARGE_BLOCK_CLASS)
+		return hdr->size;
+	return class_block_size(hdr->size_class) - BLOCK_HEADER_SIZE;
+}
+
+void geco_malloc_flush_thread_cache()
+{
+	for (unsigned int cls = 0; cls < SIZE_CLASS_NUM; cls++)
+		tcache_.flush(cls, tcache_.lists[cls].count);
+}
+size_t geco_malloc_thread_alloc_count()
+{
+	return tcache_.allocs;
+}
+void geco_malloc_get_stats(geco_malloc_stats_t* stats)
+{
+	stats->span_bytes = span_bytes_.load(std::memory_order_relaxed);
+	stats->large_bytes = large_bytes_.load(std::memory_order_relaxed);
+	stats->depot_refills = depot_refills_.load(std::memory_order_relaxed);
+	stats->depot_flushes = depot_flushes_.load(std::memory_order_relaxed);
+	stats->hugetlb_bytes = hugetlb_bytes_.load(std::memory_order_relaxed);
+	stats->thp_bytes = thp_bytes_.load(std::memory_order_relaxed);
+	stats->normal_page_bytes = normal_page_bytes_.load(std::memory_order_relaxed);
+}
+void geco_malloc_use_huge_pages(bool enable)
+{
+	use_huge_pages_.store(enable, std::memory_order_relaxed);
+}
+
+void geco_heap_profiler_enable(bool enable)
+{
+	heap_profiling_.store(enable, std::memory_order_relaxed);
+}
+bool geco_heap_profiler_enabled()
+{
+	return heap_profiling_.load(std::memory_order_relaxed);
+}
+static bool heap_site_bigger(const geco_heap_site_t& a, const geco_heap_site_t& b)
+{
+	return a.live_bytes > b.live_bytes;
+}
+static void heap_profiler_collect(std::vector<geco_heap_site_t>& sites)
+{
+	for (unsigned int i = 0; i <= HEAP_PROFILER_SITES; i++)
+	{
+		heap_site_t& site = heap_sites_[i];
+		geco_heap_site_t s;
+		s.allocs = site.allocs.load(std::memory_order_relaxed);
+		if (s.allocs == 0)
+			continue;
+		s.file = i == HEAP_PROFILER_SITES ? "<sites beyond the table>" : site.file.load(std::memory_order_relaxed);
+		s.line = site.line.load(std::memory_order_relaxed);
+		s.live_bytes = site.live_bytes.load(std::memory_order_relaxed);
+		s.live_blocks = site.live_blocks.load(std::memory_order_relaxed);
+		s.peak_bytes = site.peak_bytes.load(std::memory_order_relaxed);
+		s.alloc_bytes = site.alloc_bytes.load(std::memory_order_relaxed);
+		if (s.file == NULL)
+			s.file = "?"; // claimed by another thread this very moment
+		sites.push_back(s);
+	}
+	std::sort(sites.begin(), sites.end(), heap_site_bigger);
+}
+size_t geco_heap_profiler_snapshot(geco_heap_site_t* sites, size_t max)
+{
+	std::vector<geco_heap_site_t> all;
+	heap_profiler_collect(all);
+	for (size_t i = 0; i < max && i < all.size(); i++)
+		sites[i] = all[i];
+	return all.size();
+}
+void geco_heap_profiler_dump(FILE* out)
+{
+	std::vector<geco_heap_site_t> all;
+	heap_profiler_collect(all);
+	size_t live = 0, blocks = 0;
+	for (size_t i = 0; i < all.size(); i++)
+	{
+		live += all[i].live_bytes;
+		blocks += all[i].live_blocks;
+	}
+	fprintf(out, "geco heap profile: %zu sites, %zu live bytes in %zu blocks\n", all.size(), live, blocks);
+	fprintf(out, "%12s %12s %12s %12s %14s  site\n", "live bytes", "live blocks", "peak bytes", "allocs",
+		"alloc bytes");
+	for (size_t i = 0; i < all.size(); i++)
+		fprintf(out, "%12zu %12zu %12zu %12zu %14zu  %s:%u\n", all[i].live_bytes, all[i].live_blocks,
+			all[i].peak_bytes, all[i].allocs, all[i].alloc_bytes, all[i].file, all[i].line);
+	fflush(out);
+}
+
+static void* _DefaultMalloc_Ex(size_t size, const char *file, unsigned int line)
+{
+    return profile_block(alloc_block(size), size, file, line);
+}
+static void* _DefaultRealloc_Ex(void *p, size_t newsize, const char *file,
+    unsigned int line)
+{
+    if(p == NULL) return profile_block(alloc_block(newsize), newsize, file, line);
+    size_t oldsize = usable_size(p);
+    if(newsize <= oldsize && newsize + BLOCK_HEADER_SIZE > (oldsize >> 1))
+    {
+        block_header_t* hdr = (block_header_t*)((char*)p - BLOCK_HEADER_SIZE);
+        if(hdr->site != 0)
+        {
+            heap_site_t& site = heap_sites_[hdr->site - 1];
+            site.live_bytes.fetch_sub(hdr->size, std::memory_order_relaxed);
+            heap_site_add(site, newsize);
+        }
+        if(hdr->size_class == LARGE_BLOCK_CLASS)
+        {
+            large_bytes_.fetch_sub(hdr->size, std::memory_order_relaxed);
+            large_bytes_.fetch_add(newsize, std::memory_order_relaxed);
+        }
+        hdr->size = (unsigned int)newsize;
+        return p;
+    }
+    void* buf = profile_block(alloc_block(newsize), newsize, file, line);
+    if(buf == NULL) return NULL;
+    memcpy(buf, p, oldsize < newsize ? oldsize : newsize);
+    free_block(p);
+    return buf;
+}
+static void _DefaultFree_Ex(void *p, const char *file,unsigned int line)
+{
+    if(p == NULL) abort();
+    free_block(p);
+}
+/*function with ext for debug*/
+GecoMallocExt geco_malloc_ext = _DefaultMalloc_Ex;
+GecoReallocExt geco_realloc_ext = _DefaultRealloc_Ex;
 GecoFreeExt geco_free_ext = _DefaultFree_Ex;
\ No newline at end of file
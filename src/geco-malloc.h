@@ -1,818 +1,932 @@
-/*
- * Geco Gaming Company
- * All Rights Reserved.
- * Copyright (c)  2016 GECOEngine.
- *
- * GECOEngine is free software: you can redistribute it and/or modify
- * it under the terms of the GNU Lesser General Public License as published by
- * the Free Software Foundation, either version 3 of the License, or
- * (at your option) any later version.
- *
- * GECOEngine is distributed in the hope that it will be useful,
- * but WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
- * GNU Lesser General Public License for more details.
-
- * You should have received a copy of the GNU Lesser General Public License
- * along with KBEngine.  If not, see <http://www.gnu.org/licenses/>.
- *
- */
-
-// created on 04-June-2016 by Jackie Zhang
-#ifndef __INCLUDE_GECO_MALLOC_H
-#define __INCLUDE_GECO_MALLOC_H
-
-#if defined(__FreeBSD__)
-#include <stdlib.h>
-#elif defined ( __APPLE__ ) || defined ( __APPLE_CC__ )
-#include <malloc/malloc.h>
-#include <alloca.h>
-#elif defined(_WIN32)
-#include <malloc.h>
-#else
-#include <malloc.h>
-#include <alloca.h> // Alloca needed on Ubuntu apparently
-#endif
-#include <new>
-
-#define FILE_AND_LINE __FILE__,__LINE__
-
-// These pointers are statically and globally defined in RakMemoryOverride.cpp
-// Change them to point to your own allocators if you want.
-// Use the functions for a DLL, or just reassign the variable if using source
-typedef void*(*GecoMalloc)(size_t size);
-typedef void*(*GecoRealloc)(void *p, size_t size);
-typedef void (*GecoFree)(void *p, size_t size);
-extern GecoMalloc geco_malloc;
-extern GecoRealloc geco_realloc;
-extern GecoFree geco_free;
-
-typedef void * (*GecoMallocExt)(size_t size, const char *file, unsigned int line);
-typedef void * (*GecoReallocExt)(void *p, size_t size, const char *file, unsigned int line);
-typedef void (*GecoFreeExt)(void *p, const char *file, unsigned int line);
-extern GecoMallocExt geco_malloc_ext;
-extern GecoReallocExt geco_realloc_ext;
-extern GecoFreeExt geco_free_ext;
-
-/// new functions with different number of ctor params, up to 4
-template<class Type>
-Type* geco_new(const char *file, unsigned int line)
-{
-  char *buffer = (char *) (geco_malloc_ext)(sizeof(Type), file, line);
-  Type *t = new (buffer) Type;
-  return t;
-}
-template<class Type, class P1>
-Type* geco_new(const char *file, unsigned int line, const P1 &p1)
-{
-  char *buffer = (char *) (geco_malloc_ext)(sizeof(Type), file, line);
-  Type *t = new (buffer) Type(p1);
-  return t;
-}
-template<class Type, class P1, class P2>
-Type* geco_new(const char *file, unsigned int line, const P1 &p1, const P2 &p2)
-{
-  char *buffer = (char *) (geco_malloc_ext)(sizeof(Type), file, line);
-  Type *t = new (buffer) Type(p1, p2);
-  return t;
-}
-template<class Type, class P1, class P2, class P3>
-Type* geco_new(const char *file, unsigned int line, const P1 &p1, const P2 &p2, const P3 &p3)
-{
-  char *buffer = (char *) (geco_malloc_ext)(sizeof(Type), file, line);
-  Type *t = new (buffer) Type(p1, p2, p3);
-  return t;
-}
-template<class Type, class P1, class P2, class P3, class P4>
-Type* geco_new(const char *file, unsigned int line, const P1 &p1, const P2 &p2, const P3 &p3, const P4 &p4)
-{
-  char *buffer = (char *) (geco_malloc_ext)(sizeof(Type), file, line);
-  Type *t = new (buffer) Type(p1, p2, p3, p4);
-  return t;
-}
-
-template<class Type>
-Type* geco_new_array(const int count, const char *file, unsigned int line)
-{
-  if (count == 0)
-    return 0;
-
-  //		Type *t;
-  char *buffer = (char *) (geco_malloc_ext)(sizeof(int) + sizeof(Type) * count, file, line);
-  ((int*) buffer)[0] = count;
-  for (int i = 0; i < count; i++)
-  {
-    new (buffer + sizeof(int) + i * sizeof(Type)) Type;
-  }
-  return (Type *) (buffer + sizeof(int));
-}
-
-template<class Type>
-void geco_delete(Type *buff, const char *file, unsigned int line)
-{
-  if (buff == 0)
-    return;
-  buff->~Type();
-  geco_free_ext(buff, file, line);
-}
-
-template<class Type>
-void geco_delete_array(Type *buff, const char *file, unsigned int line)
-{
-  if (buff == 0)
-    return;
-  char* ptr = (char*) buff - sizeof(int);
-  int count = *(int*) ptr;
-  Type* tmp = (Type*) (ptr + sizeof(int));
-  for (int i = 0; i < count; i++)
-  {
-    (tmp + i)->~Type();
-  }
-  (geco_free_ext)(ptr, file, line);
-}
-
-#include <stddef.h>
-#include <stdint.h>
-#include <emmintrin.h>
-//---------------------------------------------------------------------
-// force inline for compilers
-//---------------------------------------------------------------------
-#ifndef INLINE
-#ifdef __GNUC__
-#if (__GNUC__ > 3) || ((__GNUC__ == 3) && (__GNUC_MINOR__ >= 1))
-#define INLINE         __inline__ __attribute__((always_inline))
-#else
-#define INLINE         __inline__
-#endif
-#elif defined(_MSC_VER)
-#define INLINE __forceinline
-#elif (defined(__BORLANDC__) || defined(__WATCOMC__))
-#define INLINE __inline
-#else
-#define INLINE
-#endif
-#endif
-
-//---------------------------------------------------------------------
-// fast copy for different sizes
-//---------------------------------------------------------------------
-static INLINE void memcpy_sse2_16(void *dst, const void *src)
-{
-  __m128i m0 = _mm_loadu_si128(((const __m128i *) src) + 0);
-  _mm_storeu_si128(((__m128i *) dst) + 0, m0);
-}
-
-static INLINE void memcpy_sse2_32(void *dst, const void *src)
-{
-  __m128i m0 = _mm_loadu_si128(((const __m128i *) src) + 0);
-  __m128i m1 = _mm_loadu_si128(((const __m128i *) src) + 1);
-  _mm_storeu_si128(((__m128i *) dst) + 0, m0);
-  _mm_storeu_si128(((__m128i *) dst) + 1, m1);
-}
-
-static INLINE void memcpy_sse2_64(void *dst, const void *src)
-{
-  __m128i m0 = _mm_loadu_si128(((const __m128i *) src) + 0);
-  __m128i m1 = _mm_loadu_si128(((const __m128i *) src) + 1);
-  __m128i m2 = _mm_loadu_si128(((const __m128i *) src) + 2);
-  __m128i m3 = _mm_loadu_si128(((const __m128i *) src) + 3);
-  _mm_storeu_si128(((__m128i *) dst) + 0, m0);
-  _mm_storeu_si128(((__m128i *) dst) + 1, m1);
-  _mm_storeu_si128(((__m128i *) dst) + 2, m2);
-  _mm_storeu_si128(((__m128i *) dst) + 3, m3);
-}
-
-static INLINE void memcpy_sse2_128(void *dst, const void *src)
-{
-  __m128i m0 = _mm_loadu_si128(((const __m128i *) src) + 0);
-  __m128i m1 = _mm_loadu_si128(((const __m128i *) src) + 1);
-  __m128i m2 = _mm_loadu_si128(((const __m128i *) src) + 2);
-  __m128i m3 = _mm_loadu_si128(((const __m128i *) src) + 3);
-  __m128i m4 = _mm_loadu_si128(((const __m128i *) src) + 4);
-  __m128i m5 = _mm_loadu_si128(((const __m128i *) src) + 5);
-  __m128i m6 = _mm_loadu_si128(((const __m128i *) src) + 6);
-  __m128i m7 = _mm_loadu_si128(((const __m128i *) src) + 7);
-  _mm_storeu_si128(((__m128i *) dst) + 0, m0);
-  _mm_storeu_si128(((__m128i *) dst) + 1, m1);
-  _mm_storeu_si128(((__m128i *) dst) + 2, m2);
-  _mm_storeu_si128(((__m128i *) dst) + 3, m3);
-  _mm_storeu_si128(((__m128i *) dst) + 4, m4);
-  _mm_storeu_si128(((__m128i *) dst) + 5, m5);
-  _mm_storeu_si128(((__m128i *) dst) + 6, m6);
-  _mm_storeu_si128(((__m128i *) dst) + 7, m7);
-}
-
-//---------------------------------------------------------------------
-// tiny memory copy with jump table optimized
-//---------------------------------------------------------------------
-static INLINE void *memcpy_tiny(void *dst, const void *src, size_t size)
-{
-  unsigned char *dd = ((unsigned char*) dst) + size;
-  const unsigned char *ss = ((const unsigned char*) src) + size;
-
-  switch (size)
-  {
-    case 64:
-      memcpy_sse2_64(dd - 64, ss - 64);
-    case 0:
-      break;
-
-    case 65:
-      memcpy_sse2_64(dd - 65, ss - 65);
-    case 1:
-      dd[-1] = ss[-1];
-      break;
-
-    case 66:
-      memcpy_sse2_64(dd - 66, ss - 66);
-    case 2:
-      *((uint16_t*) (dd - 2)) = *((uint16_t*) (ss - 2));
-      break;
-
-    case 67:
-      memcpy_sse2_64(dd - 67, ss - 67);
-    case 3:
-      *((uint16_t*) (dd - 3)) = *((uint16_t*) (ss - 3));
-      dd[-1] = ss[-1];
-      break;
-
-    case 68:
-      memcpy_sse2_64(dd - 68, ss - 68);
-    case 4:
-      *((uint32_t*) (dd - 4)) = *((uint32_t*) (ss - 4));
-      break;
-
-    case 69:
-      memcpy_sse2_64(dd - 69, ss - 69);
-    case 5:
-      *((uint32_t*) (dd - 5)) = *((uint32_t*) (ss - 5));
-      dd[-1] = ss[-1];
-      break;
-
-    case 70:
-      memcpy_sse2_64(dd - 70, ss - 70);
-    case 6:
-      *((uint32_t*) (dd - 6)) = *((uint32_t*) (ss - 6));
-      *((uint16_t*) (dd - 2)) = *((uint16_t*) (ss - 2));
-      break;
-
-    case 71:
-      memcpy_sse2_64(dd - 71, ss - 71);
-    case 7:
-      *((uint32_t*) (dd - 7)) = *((uint32_t*) (ss - 7));
-      *((uint32_t*) (dd - 4)) = *((uint32_t*) (ss - 4));
-      break;
-
-    case 72:
-      memcpy_sse2_64(dd - 72, ss - 72);
-    case 8:
-      *((uint64_t*) (dd - 8)) = *((uint64_t*) (ss - 8));
-      break;
-
-    case 73:
-      memcpy_sse2_64(dd - 73, ss - 73);
-    case 9:
-      *((uint64_t*) (dd - 9)) = *((uint64_t*) (ss - 9));
-      dd[-1] = ss[-1];
-      break;
-
-    case 74:
-      memcpy_sse2_64(dd - 74, ss - 74);
-    case 10:
-      *((uint64_t*) (dd - 10)) = *((uint64_t*) (ss - 10));
-      *((uint16_t*) (dd - 2)) = *((uint16_t*) (ss - 2));
-      break;
-
-    case 75:
-      memcpy_sse2_64(dd - 75, ss - 75);
-    case 11:
-      *((uint64_t*) (dd - 11)) = *((uint64_t*) (ss - 11));
-      *((uint32_t*) (dd - 4)) = *((uint32_t*) (ss - 4));
-      break;
-
-    case 76:
-      memcpy_sse2_64(dd - 76, ss - 76);
-    case 12:
-      *((uint64_t*) (dd - 12)) = *((uint64_t*) (ss - 12));
-      *((uint32_t*) (dd - 4)) = *((uint32_t*) (ss - 4));
-      break;
-
-    case 77:
-      memcpy_sse2_64(dd - 77, ss - 77);
-    case 13:
-      *((uint64_t*) (dd - 13)) = *((uint64_t*) (ss - 13));
-      *((uint32_t*) (dd - 5)) = *((uint32_t*) (ss - 5));
-      dd[-1] = ss[-1];
-      break;
-
-    case 78:
-      memcpy_sse2_64(dd - 78, ss - 78);
-    case 14:
-      *((uint64_t*) (dd - 14)) = *((uint64_t*) (ss - 14));
-      *((uint64_t*) (dd - 8)) = *((uint64_t*) (ss - 8));
-      break;
-
-    case 79:
-      memcpy_sse2_64(dd - 79, ss - 79);
-    case 15:
-      *((uint64_t*) (dd - 15)) = *((uint64_t*) (ss - 15));
-      *((uint64_t*) (dd - 8)) = *((uint64_t*) (ss - 8));
-      break;
-
-    case 80:
-      memcpy_sse2_64(dd - 80, ss - 80);
-    case 16:
-      memcpy_sse2_16(dd - 16, ss - 16);
-      break;
-
-    case 81:
-      memcpy_sse2_64(dd - 81, ss - 81);
-    case 17:
-      memcpy_sse2_16(dd - 17, ss - 17);
-      dd[-1] = ss[-1];
-      break;
-
-    case 82:
-      memcpy_sse2_64(dd - 82, ss - 82);
-    case 18:
-      memcpy_sse2_16(dd - 18, ss - 18);
-      *((uint16_t*) (dd - 2)) = *((uint16_t*) (ss - 2));
-      break;
-
-    case 83:
-      memcpy_sse2_64(dd - 83, ss - 83);
-    case 19:
-      memcpy_sse2_16(dd - 19, ss - 19);
-      *((uint16_t*) (dd - 3)) = *((uint16_t*) (ss - 3));
-      dd[-1] = ss[-1];
-      break;
-
-    case 84:
-      memcpy_sse2_64(dd - 84, ss - 84);
-    case 20:
-      memcpy_sse2_16(dd - 20, ss - 20);
-      *((uint32_t*) (dd - 4)) = *((uint32_t*) (ss - 4));
-      break;
-
-    case 85:
-      memcpy_sse2_64(dd - 85, ss - 85);
-    case 21:
-      memcpy_sse2_16(dd - 21, ss - 21);
-      *((uint32_t*) (dd - 5)) = *((uint32_t*) (ss - 5));
-      dd[-1] = ss[-1];
-      break;
-
-    case 86:
-      memcpy_sse2_64(dd - 86, ss - 86);
-    case 22:
-      memcpy_sse2_16(dd - 22, ss - 22);
-      *((uint32_t*) (dd - 6)) = *((uint32_t*) (ss - 6));
-      *((uint16_t*) (dd - 2)) = *((uint16_t*) (ss - 2));
-      break;
-
-    case 87:
-      memcpy_sse2_64(dd - 87, ss - 87);
-    case 23:
-      memcpy_sse2_16(dd - 23, ss - 23);
-      *((uint32_t*) (dd - 7)) = *((uint32_t*) (ss - 7));
-      *((uint32_t*) (dd - 4)) = *((uint32_t*) (ss - 4));
-      break;
-
-    case 88:
-      memcpy_sse2_64(dd - 88, ss - 88);
-    case 24:
-      memcpy_sse2_16(dd - 24, ss - 24);
-      memcpy_sse2_16(dd - 16, ss - 16);
-      break;
-
-    case 89:
-      memcpy_sse2_64(dd - 89, ss - 89);
-    case 25:
-      memcpy_sse2_16(dd - 25, ss - 25);
-      memcpy_sse2_16(dd - 16, ss - 16);
-      break;
-
-    case 90:
-      memcpy_sse2_64(dd - 90, ss - 90);
-    case 26:
-      memcpy_sse2_16(dd - 26, ss - 26);
-      memcpy_sse2_16(dd - 16, ss - 16);
-      break;
-
-    case 91:
-      memcpy_sse2_64(dd - 91, ss - 91);
-    case 27:
-      memcpy_sse2_16(dd - 27, ss - 27);
-      memcpy_sse2_16(dd - 16, ss - 16);
-      break;
-
-    case 92:
-      memcpy_sse2_64(dd - 92, ss - 92);
-    case 28:
-      memcpy_sse2_16(dd - 28, ss - 28);
-      memcpy_sse2_16(dd - 16, ss - 16);
-      break;
-
-    case 93:
-      memcpy_sse2_64(dd - 93, ss - 93);
-    case 29:
-      memcpy_sse2_16(dd - 29, ss - 29);
-      memcpy_sse2_16(dd - 16, ss - 16);
-      break;
-
-    case 94:
-      memcpy_sse2_64(dd - 94, ss - 94);
-    case 30:
-      memcpy_sse2_16(dd - 30, ss - 30);
-      memcpy_sse2_16(dd - 16, ss - 16);
-      break;
-
-    case 95:
-      memcpy_sse2_64(dd - 95, ss - 95);
-    case 31:
-      memcpy_sse2_16(dd - 31, ss - 31);
-      memcpy_sse2_16(dd - 16, ss - 16);
-      break;
-
-    case 96:
-      memcpy_sse2_64(dd - 96, ss - 96);
-    case 32:
-      memcpy_sse2_32(dd - 32, ss - 32);
-      break;
-
-    case 97:
-      memcpy_sse2_64(dd - 97, ss - 97);
-    case 33:
-      memcpy_sse2_32(dd - 33, ss - 33);
-      dd[-1] = ss[-1];
-      break;
-
-    case 98:
-      memcpy_sse2_64(dd - 98, ss - 98);
-    case 34:
-      memcpy_sse2_32(dd - 34, ss - 34);
-      *((uint16_t*) (dd - 2)) = *((uint16_t*) (ss - 2));
-      break;
-
-    case 99:
-      memcpy_sse2_64(dd - 99, ss - 99);
-    case 35:
-      memcpy_sse2_32(dd - 35, ss - 35);
-      *((uint16_t*) (dd - 3)) = *((uint16_t*) (ss - 3));
-      dd[-1] = ss[-1];
-      break;
-
-    case 100:
-      memcpy_sse2_64(dd - 100, ss - 100);
-    case 36:
-      memcpy_sse2_32(dd - 36, ss - 36);
-      *((uint32_t*) (dd - 4)) = *((uint32_t*) (ss - 4));
-      break;
-
-    case 101:
-      memcpy_sse2_64(dd - 101, ss - 101);
-    case 37:
-      memcpy_sse2_32(dd - 37, ss - 37);
-      *((uint32_t*) (dd - 5)) = *((uint32_t*) (ss - 5));
-      dd[-1] = ss[-1];
-      break;
-
-    case 102:
-      memcpy_sse2_64(dd - 102, ss - 102);
-    case 38:
-      memcpy_sse2_32(dd - 38, ss - 38);
-      *((uint32_t*) (dd - 6)) = *((uint32_t*) (ss - 6));
-      *((uint16_t*) (dd - 2)) = *((uint16_t*) (ss - 2));
-      break;
-
-    case 103:
-      memcpy_sse2_64(dd - 103, ss - 103);
-    case 39:
-      memcpy_sse2_32(dd - 39, ss - 39);
-      *((uint32_t*) (dd - 7)) = *((uint32_t*) (ss - 7));
-      *((uint32_t*) (dd - 4)) = *((uint32_t*) (ss - 4));
-      break;
-
-    case 104:
-      memcpy_sse2_64(dd - 104, ss - 104);
-    case 40:
-      memcpy_sse2_32(dd - 40, ss - 40);
-      *((uint64_t*) (dd - 8)) = *((uint64_t*) (ss - 8));
-      break;
-
-    case 105:
-      memcpy_sse2_64(dd - 105, ss - 105);
-    case 41:
-      memcpy_sse2_32(dd - 41, ss - 41);
-      *((uint64_t*) (dd - 9)) = *((uint64_t*) (ss - 9));
-      dd[-1] = ss[-1];
-      break;
-
-    case 106:
-      memcpy_sse2_64(dd - 106, ss - 106);
-    case 42:
-      memcpy_sse2_32(dd - 42, ss - 42);
-      *((uint64_t*) (dd - 10)) = *((uint64_t*) (ss - 10));
-      *((uint16_t*) (dd - 2)) = *((uint16_t*) (ss - 2));
-      break;
-
-    case 107:
-      memcpy_sse2_64(dd - 107, ss - 107);
-    case 43:
-      memcpy_sse2_32(dd - 43, ss - 43);
-      *((uint64_t*) (dd - 11)) = *((uint64_t*) (ss - 11));
-      *((uint32_t*) (dd - 4)) = *((uint32_t*) (ss - 4));
-      break;
-
-    case 108:
-      memcpy_sse2_64(dd - 108, ss - 108);
-    case 44:
-      memcpy_sse2_32(dd - 44, ss - 44);
-      *((uint64_t*) (dd - 12)) = *((uint64_t*) (ss - 12));
-      *((uint32_t*) (dd - 4)) = *((uint32_t*) (ss - 4));
-      break;
-
-    case 109:
-      memcpy_sse2_64(dd - 109, ss - 109);
-    case 45:
-      memcpy_sse2_32(dd - 45, ss - 45);
-      *((uint64_t*) (dd - 13)) = *((uint64_t*) (ss - 13));
-      *((uint32_t*) (dd - 5)) = *((uint32_t*) (ss - 5));
-      dd[-1] = ss[-1];
-      break;
-
-    case 110:
-      memcpy_sse2_64(dd - 110, ss - 110);
-    case 46:
-      memcpy_sse2_32(dd - 46, ss - 46);
-      *((uint64_t*) (dd - 14)) = *((uint64_t*) (ss - 14));
-      *((uint64_t*) (dd - 8)) = *((uint64_t*) (ss - 8));
-      break;
-
-    case 111:
-      memcpy_sse2_64(dd - 111, ss - 111);
-    case 47:
-      memcpy_sse2_32(dd - 47, ss - 47);
-      *((uint64_t*) (dd - 15)) = *((uint64_t*) (ss - 15));
-      *((uint64_t*) (dd - 8)) = *((uint64_t*) (ss - 8));
-      break;
-
-    case 112:
-      memcpy_sse2_64(dd - 112, ss - 112);
-    case 48:
-      memcpy_sse2_32(dd - 48, ss - 48);
-      memcpy_sse2_16(dd - 16, ss - 16);
-      break;
-
-    case 113:
-      memcpy_sse2_64(dd - 113, ss - 113);
-    case 49:
-      memcpy_sse2_32(dd - 49, ss - 49);
-      memcpy_sse2_16(dd - 17, ss - 17);
-      dd[-1] = ss[-1];
-      break;
-
-    case 114:
-      memcpy_sse2_64(dd - 114, ss - 114);
-    case 50:
-      memcpy_sse2_32(dd - 50, ss - 50);
-      memcpy_sse2_16(dd - 18, ss - 18);
-      *((uint16_t*) (dd - 2)) = *((uint16_t*) (ss - 2));
-      break;
-
-    case 115:
-      memcpy_sse2_64(dd - 115, ss - 115);
-    case 51:
-      memcpy_sse2_32(dd - 51, ss - 51);
-      memcpy_sse2_16(dd - 19, ss - 19);
-      *((uint16_t*) (dd - 3)) = *((uint16_t*) (ss - 3));
-      dd[-1] = ss[-1];
-      break;
-
-    case 116:
-      memcpy_sse2_64(dd - 116, ss - 116);
-    case 52:
-      memcpy_sse2_32(dd - 52, ss - 52);
-      memcpy_sse2_16(dd - 20, ss - 20);
-      *((uint32_t*) (dd - 4)) = *((uint32_t*) (ss - 4));
-      break;
-
-    case 117:
-      memcpy_sse2_64(dd - 117, ss - 117);
-    case 53:
-      memcpy_sse2_32(dd - 53, ss - 53);
-      memcpy_sse2_16(dd - 21, ss - 21);
-      *((uint32_t*) (dd - 5)) = *((uint32_t*) (ss - 5));
-      dd[-1] = ss[-1];
-      break;
-
-    case 118:
-      memcpy_sse2_64(dd - 118, ss - 118);
-    case 54:
-      memcpy_sse2_32(dd - 54, ss - 54);
-      memcpy_sse2_16(dd - 22, ss - 22);
-      *((uint32_t*) (dd - 6)) = *((uint32_t*) (ss - 6));
-      *((uint16_t*) (dd - 2)) = *((uint16_t*) (ss - 2));
-      break;
-
-    case 119:
-      memcpy_sse2_64(dd - 119, ss - 119);
-    case 55:
-      memcpy_sse2_32(dd - 55, ss - 55);
-      memcpy_sse2_16(dd - 23, ss - 23);
-      *((uint32_t*) (dd - 7)) = *((uint32_t*) (ss - 7));
-      *((uint32_t*) (dd - 4)) = *((uint32_t*) (ss - 4));
-      break;
-
-    case 120:
-      memcpy_sse2_64(dd - 120, ss - 120);
-    case 56:
-      memcpy_sse2_32(dd - 56, ss - 56);
-      memcpy_sse2_16(dd - 24, ss - 24);
-      memcpy_sse2_16(dd - 16, ss - 16);
-      break;
-
-    case 121:
-      memcpy_sse2_64(dd - 121, ss - 121);
-    case 57:
-      memcpy_sse2_32(dd - 57, ss - 57);
-      memcpy_sse2_16(dd - 25, ss - 25);
-      memcpy_sse2_16(dd - 16, ss - 16);
-      break;
-
-    case 122:
-      memcpy_sse2_64(dd - 122, ss - 122);
-    case 58:
-      memcpy_sse2_32(dd - 58, ss - 58);
-      memcpy_sse2_16(dd - 26, ss - 26);
-      memcpy_sse2_16(dd - 16, ss - 16);
-      break;
-
-    case 123:
-      memcpy_sse2_64(dd - 123, ss - 123);
-    case 59:
-      memcpy_sse2_32(dd - 59, ss - 59);
-      memcpy_sse2_16(dd - 27, ss - 27);
-      memcpy_sse2_16(dd - 16, ss - 16);
-      break;
-
-    case 124:
-      memcpy_sse2_64(dd - 124, ss - 124);
-    case 60:
-      memcpy_sse2_32(dd - 60, ss - 60);
-      memcpy_sse2_16(dd - 28, ss - 28);
-      memcpy_sse2_16(dd - 16, ss - 16);
-      break;
-
-    case 125:
-      memcpy_sse2_64(dd - 125, ss - 125);
-    case 61:
-      memcpy_sse2_32(dd - 61, ss - 61);
-      memcpy_sse2_16(dd - 29, ss - 29);
-      memcpy_sse2_16(dd - 16, ss - 16);
-      break;
-
-    case 126:
-      memcpy_sse2_64(dd - 126, ss - 126);
-    case 62:
-      memcpy_sse2_32(dd - 62, ss - 62);
-      memcpy_sse2_16(dd - 30, ss - 30);
-      memcpy_sse2_16(dd - 16, ss - 16);
-      break;
-
-    case 127:
-      memcpy_sse2_64(dd - 127, ss - 127);
-    case 63:
-      memcpy_sse2_32(dd - 63, ss - 63);
-      memcpy_sse2_16(dd - 31, ss - 31);
-      memcpy_sse2_16(dd - 16, ss - 16);
-      break;
-
-    case 128:
-      memcpy_sse2_128(dd - 128, ss - 128);
-      break;
-  }
-
-  return dst;
-}
-
-//---------------------------------------------------------------------
-// main routine
-//---------------------------------------------------------------------
-static void* memcpy_fast(void *destination, const void *source, size_t size)
-{
-  unsigned char *dst = (unsigned char*) destination;
-  const unsigned char *src = (const unsigned char*) source;
-  static size_t cachesize = 0x200000; // L2-cache size
-  size_t padding;
-
-  // small memory copy
-  if (size <= 128)
-  {
-    return memcpy_tiny(dst, src, size);
-  }
-
-  // align destination to 16 bytes boundary
-  padding = (16 - (((size_t) dst) & 15)) & 15;
-
-  if (padding > 0)
-  {
-    __m128i head = _mm_loadu_si128((const __m128i *) src);
-    _mm_storeu_si128((__m128i *) dst, head);
-    dst += padding;
-    src += padding;
-    size -= padding;
-  }
-
-  // medium size copy
-  if (size <= cachesize)
-  {
-    __m128i c0, c1, c2, c3, c4, c5, c6, c7;
-
-    for (; size >= 128; size -= 128)
-    {
-      c0 = _mm_loadu_si128(((const __m128i *) src) + 0);
-      c1 = _mm_loadu_si128(((const __m128i *) src) + 1);
-      c2 = _mm_loadu_si128(((const __m128i *) src) + 2);
-      c3 = _mm_loadu_si128(((const __m128i *) src) + 3);
-      c4 = _mm_loadu_si128(((const __m128i *) src) + 4);
-      c5 = _mm_loadu_si128(((const __m128i *) src) + 5);
-      c6 = _mm_loadu_si128(((const __m128i *) src) + 6);
-      c7 = _mm_loadu_si128(((const __m128i *) src) + 7);
-      _mm_prefetch((const char* )(src + 256), _MM_HINT_NTA);
-      src += 128;
-      _mm_store_si128((((__m128i *) dst) + 0), c0);
-      _mm_store_si128((((__m128i *) dst) + 1), c1);
-      _mm_store_si128((((__m128i *) dst) + 2), c2);
-      _mm_store_si128((((__m128i *) dst) + 3), c3);
-      _mm_store_si128((((__m128i *) dst) + 4), c4);
-      _mm_store_si128((((__m128i *) dst) + 5), c5);
-      _mm_store_si128((((__m128i *) dst) + 6), c6);
-      _mm_store_si128((((__m128i *) dst) + 7), c7);
-      dst += 128;
-    }
-  }
-  else
-  {   // big memory copy
-    __m128i c0, c1, c2, c3, c4, c5, c6, c7;
-
-    _mm_prefetch((const char* )(src), _MM_HINT_NTA);
-
-    if ((((size_t) src) & 15) == 0)
-    { // source aligned
-      for (; size >= 128; size -= 128)
-      {
-        c0 = _mm_load_si128(((const __m128i *) src) + 0);
-        c1 = _mm_load_si128(((const __m128i *) src) + 1);
-        c2 = _mm_load_si128(((const __m128i *) src) + 2);
-        c3 = _mm_load_si128(((const __m128i *) src) + 3);
-        c4 = _mm_load_si128(((const __m128i *) src) + 4);
-        c5 = _mm_load_si128(((const __m128i *) src) + 5);
-        c6 = _mm_load_si128(((const __m128i *) src) + 6);
-        c7 = _mm_load_si128(((const __m128i *) src) + 7);
-        _mm_prefetch((const char* )(src + 256), _MM_HINT_NTA);
-        src += 128;
-        _mm_stream_si128((((__m128i *) dst) + 0), c0);
-        _mm_stream_si128((((__m128i *) dst) + 1), c1);
-        _mm_stream_si128((((__m128i *) dst) + 2), c2);
-        _mm_stream_si128((((__m128i *) dst) + 3), c3);
-        _mm_stream_si128((((__m128i *) dst) + 4), c4);
-        _mm_stream_si128((((__m128i *) dst) + 5), c5);
-        _mm_stream_si128((((__m128i *) dst) + 6), c6);
-        _mm_stream_si128((((__m128i *) dst) + 7), c7);
-        dst += 128;
-      }
-    }
-    else
-    {             // source unaligned
-      for (; size >= 128; size -= 128)
-      {
-        c0 = _mm_loadu_si128(((const __m128i *) src) + 0);
-        c1 = _mm_loadu_si128(((const __m128i *) src) + 1);
-        c2 = _mm_loadu_si128(((const __m128i *) src) + 2);
-        c3 = _mm_loadu_si128(((const __m128i *) src) + 3);
-        c4 = _mm_loadu_si128(((const __m128i *) src) + 4);
-        c5 = _mm_loadu_si128(((const __m128i *) src) + 5);
-        c6 = _mm_loadu_si128(((const __m128i *) src) + 6);
-        c7 = _mm_loadu_si128(((const __m128i *) src) + 7);
-        _mm_prefetch((const char* )(src + 256), _MM_HINT_NTA);
-        src += 128;
-        _mm_stream_si128((((__m128i *) dst) + 0), c0);
-        _mm_stream_si128((((__m128i *) dst) + 1), c1);
-        _mm_stream_si128((((__m128i *) dst) + 2), c2);
-        _mm_stream_si128((((__m128i *) dst) + 3), c3);
-        _mm_stream_si128((((__m128i *) dst) + 4), c4);
-        _mm_stream_si128((((__m128i *) dst) + 5), c5);
-        _mm_stream_si128((((__m128i *) dst) + 6), c6);
-        _mm_stream_si128((((__m128i *) dst) + 7), c7);
-        dst += 128;
-      }
-    }
-    _mm_sfence();
-  }
-
-  memcpy_tiny(dst, src, size);
-
-  return destination;
-}
-#endif
+/*
+ * Geco Gaming Company
+ * All Rights Reserved.
+ * Copyright (c)  2016 GECOEngine.
+ *
+ * GECOEngine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GECOEngine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with KBEngine.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// created on 04-June-2016 by Jackie Zhang
+#ifndef __INCLUDE_GECO_MALLOC_H
+#define __INCLUDE_GECO_MALLOC_H
+
+#if defined(__FreeBSD__)
+#include <stdlib.h>
+#elif defined ( __APPLE__ ) || defined ( __APPLE_CC__ )
+#include <malloc/malloc.h>
+#include <alloca.h>
+#elif defined(_WIN32)
+#include <malloc.h>
+#else
+#include <malloc.h>
+#include <alloca.h> // Alloca needed on Ubuntu apparently
+#endif
+#include <new>
+#include <stdio.h>
+
+#define FILE_AND_LINE __FILE__,__LINE__
+
+// These pointers are statically and globally defined in RakMemoryOverride.cpp
+// Change them to point to your own allocators if you want.
+// Use the functions for a DLL, or just reassign the variable if using source
+typedef void*(*GecoMalloc)(size_t size);
+typedef void*(*GecoRealloc)(void *p, size_t size);
+typedef void (*GecoFree)(void *p, size_t size);
+extern GecoMalloc geco_malloc;
+extern GecoRealloc geco_realloc;
+extern GecoFree geco_free;
+
+typedef void * (*GecoMallocExt)(size_t size, const char *file, unsigned int line);
+typedef void * (*GecoReallocExt)(void *p, size_t size, const char *file, unsigned int line);
+typedef void (*GecoFreeExt)(void *p, const char *file, unsigned int line);
+extern GecoMallocExt geco_malloc_ext;
+extern GecoReallocExt geco_realloc_ext;
+extern GecoFreeExt geco_free_ext;
+
+/// the default geco_malloc_ext is a thread caching size class allocator, memory returned
+/// is 16 bytes aligned and may be freed by any thread
+struct geco_malloc_stats_t
+{
+  size_t span_bytes; ///< bytes taken from the system for small blocks
+  size_t large_bytes; ///< bytes in use by blocks bigger than the biggest size class
+  size_t depot_refills; ///< batches handed from the central depots to thread caches
+  size_t depot_flushes; ///< batches handed back from thread caches to the central depots
+  size_t hugetlb_bytes; ///< span arenas mapped with MAP_HUGETLB
+  size_t thp_bytes; ///< span arenas advised with MADV_HUGEPAGE
+  size_t normal_page_bytes; ///< span arenas and spans on normal pages
+};
+extern void geco_malloc_get_stats(geco_malloc_stats_t* stats);
+/// spans come from 2MB huge page arenas unless disabled, on by default, only affects
+/// spans taken from the system afterwards
+extern void geco_malloc_use_huge_pages(bool enable);
+/// gives all blocks cached by the calling thread back to the central depots,
+/// done automatically when the thread exits
+extern void geco_malloc_flush_thread_cache();
+/// number of blocks the calling thread got from geco_malloc_ext so far
+extern size_t geco_malloc_thread_alloc_count();
+
+/// heap profiler of geco_malloc_ext call sites. a site is the file pointer and line passed
+/// to geco_malloc_ext or geco_realloc_ext, blocks are charged to the site that allocated them
+/// whoever frees them. off by default, when off an allocation only pays one relaxed load.
+/// blocks allocated while it was off are not counted, also after it is turned on.
+struct geco_heap_site_t
+{
+  const char* file;
+  unsigned int line;
+  size_t live_bytes; ///< bytes of the blocks of this site not freed yet
+  size_t live_blocks;
+  size_t peak_bytes; ///< highest live_bytes seen
+  size_t allocs; ///< blocks allocated so far
+  size_t alloc_bytes; ///< bytes allocated so far
+};
+extern void geco_heap_profiler_enable(bool enable);
+extern bool geco_heap_profiler_enabled();
+/// copies the first max sites ordered by live bytes, biggest first
+/// @return number of sites profiled, may be bigger than max
+extern size_t geco_heap_profiler_snapshot(geco_heap_site_t* sites, size_t max);
+/// writes all sites ordered by live bytes to out, done by free_library() when enabled
+extern void geco_heap_profiler_dump(FILE* out);
+
+/// new functions with different number of ctor params, up to 4
+template<class Type>
+Type* geco_new(const char *file, unsigned int line)
+{
+  char *buffer = (char *) (geco_malloc_ext)(sizeof(Type), file, line);
+  Type *t = new (buffer) Type;
+  return t;
+}
+template<class Type, class P1>
+Type* geco_new(const char *file, unsigned int line, const P1 &p1)
+{
+  char *buffer = (char *) (geco_malloc_ext)(sizeof(Type), file, line);
+  Type *t = new (buffer) Type(p1);
+  return t;
+}
+template<class Type, class P1, class P2>
+Type* geco_new(const char *file, unsigned int line, const P1 &p1, const P2 &p2)
+{
+  char *buffer = (char *) (geco_malloc_ext)(sizeof(Type), file, line);
+  Type *t = new (buffer) Type(p1, p2);
+  return t;
+}
+template<class Type, class P1, class P2, class P3>
+Type* geco_new(const char *file, unsigned int line, const P1 &p1, const P2 &p2, const P3 &p3)
+{
+  char *buffer = (char *) (geco_malloc_ext)(sizeof(Type), file, line);
+  Type *t = new (buffer) Type(p1, p2, p3);
+  return t;
+}
+template<class Type, class P1, class P2, class P3, class P4>
+Type* geco_new(const char *file, unsigned int line, const P1 &p1, const P2 &p2, const P3 &p3, const P4 &p4)
+{
+  char *buffer = (char *) (geco_malloc_ext)(sizeof(Type), file, line);
+  Type *t = new (buffer) Type(p1, p2, p3, p4);
+  return t;
+}
+
+template<class Type>
+Type* geco_new_array(const int count, const char *file, unsigned int line)
+{
+  if (count == 0)
+    return 0;
+
+  //		Type *t;
+  char *buffer = (char *) (geco_malloc_ext)(sizeof(int) + sizeof(Type) * count, file, line);
+  ((int*) buffer)[0] = count;
+  for (int i = 0; i < count; i++)
+  {
+    new (buffer + sizeof(int) + i * sizeof(Type)) Type;
+  }
+  return (Type *) (buffer + sizeof(int));
+}
+
+template<class Type>
+void geco_delete(Type *buff, const char *file, unsigned int line)
+{
+  if (buff == 0)
+    return;
+  buff->~Type();
+  geco_free_ext(buff, file, line);
+}
+
+template<class Type>
+void geco_delete_array(Type *buff, const char *file, unsigned int line)
+{
+  if (buff == 0)
+    return;
+  char* ptr = (char*) buff - sizeof(int);
+  int count = *(int*) ptr;
+  Type* tmp = (Type*) (ptr + sizeof(int));
+  for (int i = 0; i < count; i++)
+  {
+    (tmp + i)->~Type();
+  }
+  (geco_free_ext)(ptr, file, line);
+}
+
+/// free list of one type for the objects allocated and freed per chunk or per event.
+/// objects come from geco_malloc_ext and are neither constructed nor destructed, so a pooled
+/// object may also be given back with geco_free_ext and a geco_malloc_ext'ed object may be
+/// put into the pool. the pool keeps at most high_watermark free objects, a free beyond that
+/// trims the pool down to low_watermark. not thread safe, keep one pool per thread.
+/// file and line are the caller's, they tag the objects in the heap profile
+/// Size is the object size, bigger than sizeof(Type) for types with a trailing buffer
+template<class Type, size_t Size = sizeof(Type)>
+class object_pool_t
+{
+  void* free_list_;
+  unsigned int free_num_;
+  unsigned int low_watermark_;
+  unsigned int high_watermark_;
+
+  public:
+  object_pool_t(unsigned int low_watermark, unsigned int high_watermark) :
+      free_list_(0), free_num_(0), low_watermark_(low_watermark), high_watermark_(high_watermark)
+  {
+  }
+  ~object_pool_t()
+  {
+    trim(0, __FILE__, __LINE__);
+  }
+  /// pre-warms the pool up to n free objects
+  void reserve(unsigned int n, const char *file, unsigned int line)
+  {
+    void* obj;
+    while (free_num_ < n && (obj = (geco_malloc_ext)(Size, file, line)) != 0)
+    {
+      *(void**) obj = free_list_;
+      free_list_ = obj;
+      free_num_++;
+    }
+  }
+  Type* alloc(const char *file, unsigned int line)
+  {
+    void* obj = free_list_;
+    if (obj == 0)
+      return (Type*) (geco_malloc_ext)(Size, file, line);
+    free_list_ = *(void**) obj;
+    free_num_--;
+    return (Type*) obj;
+  }
+  void free(Type* obj, const char *file, unsigned int line)
+  {
+    *(void**) obj = free_list_;
+    free_list_ = obj;
+    if (++free_num_ > high_watermark_)
+      trim(low_watermark_, file, line);
+  }
+  /// gives free objects back to geco_free_ext until keep are left
+  void trim(unsigned int keep, const char *file, unsigned int line)
+  {
+    void* obj;
+    while (free_num_ > keep)
+    {
+      obj = free_list_;
+      free_list_ = *(void**) obj;
+      free_num_--;
+      (geco_free_ext)(obj, file, line);
+    }
+  }
+  unsigned int free_num() const
+  {
+    return free_num_;
+  }
+};
+
+#include <stddef.h>
+#include <stdint.h>
+#include <emmintrin.h>
+//---------------------------------------------------------------------
+// force inline for compilers
+//---------------------------------------------------------------------
+#ifndef INLINE
+#ifdef __GNUC__
+#if (__GNUC__ > 3) || ((__GNUC__ == 3) && (__GNUC_MINOR__ >= 1))
+#define INLINE         __inline__ __attribute__((always_inline))
+#else
+#define INLINE         __inline__
+#endif
+#elif defined(_MSC_VER)
+#define INLINE __forceinline
+#elif (defined(__BORLANDC__) || defined(__WATCOMC__))
+#define INLINE __inline
+#else
+#define INLINE
+#endif
+#endif
+
+//---------------------------------------------------------------------
+// fast copy for different sizes
+//---------------------------------------------------------------------
+static INLINE void memcpy_sse2_16(void *dst, const void *src)
+{
+  __m128i m0 = _mm_loadu_si128(((const __m128i *) src) + 0);
+  _mm_storeu_si128(((__m128i *) dst) + 0, m0);
+}
+
+static INLINE void memcpy_sse2_32(void *dst, const void *src)
+{
+  __m128i m0 = _mm_loadu_si128(((const __m128i *) src) + 0);
+  __m128i m1 = _mm_loadu_si128(((const __m128i *) src) + 1);
+  _mm_storeu_si128(((__m128i *) dst) + 0, m0);
+  _mm_storeu_si128(((__m128i *) dst) + 1, m1);
+}
+
+static INLINE void memcpy_sse2_64(void *dst, const void *src)
+{
+  __m128i m0 = _mm_loadu_si128(((const __m128i *) src) + 0);
+  __m128i m1 = _mm_loadu_si128(((const __m128i *) src) + 1);
+  __m128i m2 = _mm_loadu_si128(((const __m128i *) src) + 2);
+  __m128i m3 = _mm_loadu_si128(((const __m128i *) src) + 3);
+  _mm_storeu_si128(((__m128i *) dst) + 0, m0);
+  _mm_storeu_si128(((__m128i *) dst) + 1, m1);
+  _mm_storeu_si128(((__m128i *) dst) + 2, m2);
+  _mm_storeu_si128(((__m128i *) dst) + 3, m3);
+}
+
+static INLINE void memcpy_sse2_128(void *dst, const void *src)
+{
+  __m128i m0 = _mm_loadu_si128(((const __m128i *) src) + 0);
+  __m128i m1 = _mm_loadu_si128(((const __m128i *) src) + 1);
+  __m128i m2 = _mm_loadu_si128(((const __m128i *) src) + 2);
+  __m128i m3 = _mm_loadu_si128(((const __m128i *) src) + 3);
+  __m128i m4 = _mm_loadu_si128(((const __m128i *) src) + 4);
+  __m128i m5 = _mm_loadu_si128(((const __m128i *) src) + 5);
+  __m128i m6 = _mm_loadu_si128(((const __m128i *) src) + 6);
+  __m128i m7 = _mm_loadu_si128(((const __m128i *) src) + 7);
+  _mm_storeu_si128(((__m128i *) dst) + 0, m0);
+  _mm_storeu_si128(((__m128i *) dst) + 1, m1);
+  _mm_storeu_si128(((__m128i *) dst) + 2, m2);
+  _mm_storeu_si128(((__m128i *) dst) + 3, m3);
+  _mm_storeu_si128(((__m128i *) dst) + 4, m4);
+  _mm_storeu_si128(((__m128i *) dst) + 5, m5);
+  _mm_storeu_si128(((__m128i *) dst) + 6, m6);
+  _mm_storeu_si128(((__m128i *) dst) + 7, m7);
+}
+
+//---------------------------------------------------------------------
+// tiny memory copy with jump table optimized
+//---------------------------------------------------------------------
+static INLINE void *memcpy_tiny(void *dst, const void *src, size_t size)
+{
+  unsigned char *dd = ((unsigned char*) dst) + size;
+  const unsigned char *ss = ((const unsigned char*) src) + size;
+
+  switch (size)
+  {
+    case 64:
+      memcpy_sse2_64(dd - 64, ss - 64);
+    case 0:
+      break;
+
+    case 65:
+      memcpy_sse2_64(dd - 65, ss - 65);
+    case 1:
+      dd[-1] = ss[-1];
+      break;
+
+    case 66:
+      memcpy_sse2_64(dd - 66, ss - 66);
+    case 2:
+      *((uint16_t*) (dd - 2)) = *((uint16_t*) (ss - 2));
+      break;
+
+    case 67:
+      memcpy_sse2_64(dd - 67, ss - 67);
+    case 3:
+      *((uint16_t*) (dd - 3)) = *((uint16_t*) (ss - 3));
+      dd[-1] = ss[-1];
+      break;
+
+    case 68:
+      memcpy_sse2_64(dd - 68, ss - 68);
+    case 4:
+      *((uint32_t*) (dd - 4)) = *((uint32_t*) (ss - 4));
+      break;
+
+    case 69:
+      memcpy_sse2_64(dd - 69, ss - 69);
+    case 5:
+      *((uint32_t*) (dd - 5)) = *((uint32_t*) (ss - 5));
+      dd[-1] = ss[-1];
+      break;
+
+    case 70:
+      memcpy_sse2_64(dd - 70, ss - 70);
+    case 6:
+      *((uint32_t*) (dd - 6)) = *((uint32_t*) (ss - 6));
+      *((uint16_t*) (dd - 2)) = *((uint16_t*) (ss - 2));
+      break;
+
+    case 71:
+      memcpy_sse2_64(dd - 71, ss - 71);
+    case 7:
+      *((uint32_t*) (dd - 7)) = *((uint32_t*) (ss - 7));
+      *((uint32_t*) (dd - 4)) = *((uint32_t*) (ss - 4));
+      break;
+
+    case 72:
+      memcpy_sse2_64(dd - 72, ss - 72);
+    case 8:
+      *((uint64_t*) (dd - 8)) = *((uint64_t*) (ss - 8));
+      break;
+
+    case 73:
+      memcpy_sse2_64(dd - 73, ss - 73);
+    case 9:
+      *((uint64_t*) (dd - 9)) = *((uint64_t*) (ss - 9));
+      dd[-1] = ss[-1];
+      break;
+
+    case 74:
+      memcpy_sse2_64(dd - 74, ss - 74);
+    case 10:
+      *((uint64_t*) (dd - 10)) = *((uint64_t*) (ss - 10));
+      *((uint16_t*) (dd - 2)) = *((uint16_t*) (ss - 2));
+      break;
+
+    case 75:
+      memcpy_sse2_64(dd - 75, ss - 75);
+    case 11:
+      *((uint64_t*) (dd - 11)) = *((uint64_t*) (ss - 11));
+      *((uint32_t*) (dd - 4)) = *((uint32_t*) (ss - 4));
+      break;
+
+    case 76:
+      memcpy_sse2_64(dd - 76, ss - 76);
+    case 12:
+      *((uint64_t*) (dd - 12)) = *((uint64_t*) (ss - 12));
+      *((uint32_t*) (dd - 4)) = *((uint32_t*) (ss - 4));
+      break;
+
+    case 77:
+      memcpy_sse2_64(dd - 77, ss - 77);
+    case 13:
+      *((uint64_t*) (dd - 13)) = *((uint64_t*) (ss - 13));
+      *((uint32_t*) (dd - 5)) = *((uint32_t*) (ss - 5));
+      dd[-1] = ss[-1];
+      break;
+
+    case 78:
+      memcpy_sse2_64(dd - 78, ss - 78);
+    case 14:
+      *((uint64_t*) (dd - 14)) = *((uint64_t*) (ss - 14));
+      *((uint64_t*) (dd - 8)) = *((uint64_t*) (ss - 8));
+      break;
+
+    case 79:
+      memcpy_sse2_64(dd - 79, ss - 79);
+    case 15:
+      *((uint64_t*) (dd - 15)) = *((uint64_t*) (ss - 15));
+      *((uint64_t*) (dd - 8)) = *((uint64_t*) (ss - 8));
+      break;
+
+    case 80:
+      memcpy_sse2_64(dd - 80, ss - 80);
+    case 16:
+      memcpy_sse2_16(dd - 16, ss - 16);
+      break;
+
+    case 81:
+      memcpy_sse2_64(dd - 81, ss - 81);
+    case 17:
+      memcpy_sse2_16(dd - 17, ss - 17);
+      dd[-1] = ss[-1];
+      break;
+
+    case 82:
+      memcpy_sse2_64(dd - 82, ss - 82);
+    case 18:
+      memcpy_sse2_16(dd - 18, ss - 18);
+      *((uint16_t*) (dd - 2)) = *((uint16_t*) (ss - 2));
+      break;
+
+    case 83:
+      memcpy_sse2_64(dd - 83, ss - 83);
+    case 19:
+      memcpy_sse2_16(dd - 19, ss - 19);
+      *((uint16_t*) (dd - 3)) = *((uint16_t*) (ss - 3));
+      dd[-1] = ss[-1];
+      break;
+
+    case 84:
+      memcpy_sse2_64(dd - 84, ss - 84);
+    case 20:
+      memcpy_sse2_16(dd - 20, ss - 20);
+      *((uint32_t*) (dd - 4)) = *((uint32_t*) (ss - 4));
+      break;
+
+    case 85:
+      memcpy_sse2_64(dd - 85, ss - 85);
+    case 21:
+      memcpy_sse2_16(dd - 21, ss - 21);
+      *((uint32_t*) (dd - 5)) = *((uint32_t*) (ss - 5));
+      dd[-1] = ss[-1];
+      break;
+
+    case 86:
+      memcpy_sse2_64(dd - 86, ss - 86);
+    case 22:
+      memcpy_sse2_16(dd - 22, ss - 22);
+      *((uint32_t*) (dd - 6)) = *((uint32_t*) (ss - 6));
+      *((uint16_t*) (dd - 2)) = *((uint16_t*) (ss - 2));
+      break;
+
+    case 87:
+      memcpy_sse2_64(dd - 87, ss - 87);
+    case 23:
+      memcpy_sse2_16(dd - 23, ss - 23);
+      *((uint32_t*) (dd - 7)) = *((uint32_t*) (ss - 7));
+      *((uint32_t*) (dd - 4)) = *((uint32_t*) (ss - 4));
+      break;
+
+    case 88:
+      memcpy_sse2_64(dd - 88, ss - 88);
+    case 24:
+      memcpy_sse2_16(dd - 24, ss - 24);
+      memcpy_sse2_16(dd - 16, ss - 16);
+      break;
+
+    case 89:
+      memcpy_sse2_64(dd - 89, ss - 89);
+    case 25:
+      memcpy_sse2_16(dd - 25, ss - 25);
+      memcpy_sse2_16(dd - 16, ss - 16);
+      break;
+
+    case 90:
+      memcpy_sse2_64(dd - 90, ss - 90);
+    case 26:
+      memcpy_sse2_16(dd - 26, ss - 26);
+      memcpy_sse2_16(dd - 16, ss - 16);
+      break;
+
+    case 91:
+      memcpy_sse2_64(dd - 91, ss - 91);
+    case 27:
+      memcpy_sse2_16(dd - 27, ss - 27);
+      memcpy_sse2_16(dd - 16, ss - 16);
+      break;
+
+    case 92:
+      memcpy_sse2_64(dd - 92, ss - 92);
+    case 28:
+      memcpy_sse2_16(dd - 28, ss - 28);
+      memcpy_sse2_16(dd - 16, ss - 16);
+      break;
+
+    case 93:
+      memcpy_sse2_64(dd - 93, ss - 93);
+    case 29:
+      memcpy_sse2_16(dd - 29, ss - 29);
+      memcpy_sse2_16(dd - 16, ss - 16);
+      break;
+
+    case 94:
+      memcpy_sse2_64(dd - 94, ss - 94);
+    case 30:
+      memcpy_sse2_16(dd - 30, ss - 30);
+      memcpy_sse2_16(dd - 16, ss - 16);
+      break;
+
+    case 95:
+      memcpy_sse2_64(dd - 95, ss - 95);
+    case 31:
+      memcpy_sse2_16(dd - 31, ss - 31);
+      memcpy_sse2_16(dd - 16, ss - 16);
+      break;
+
+    case 96:
+      memcpy_sse2_64(dd - 96, ss - 96);
+    case 32:
+      memcpy_sse2_32(dd - 32, ss - 32);
+      break;
+
+    case 97:
+      memcpy_sse2_64(dd - 97, ss - 97);
+    case 33:
+      memcpy_sse2_32(dd - 33, ss - 33);
+      dd[-1] = ss[-1];
+      break;
+
+    case 98:
+      memcpy_sse2_64(dd - 98, ss - 98);
+    case 34:
+      memcpy_sse2_32(dd - 34, ss - 34);
+      *((uint16_t*) (dd - 2)) = *((uint16_t*) (ss - 2));
+      break;
+
+    case 99:
+      memcpy_sse2_64(dd - 99, ss - 99);
+    case 35:
+      memcpy_sse2_32(dd - 35, ss - 35);
+      *((uint16_t*) (dd - 3)) = *((uint16_t*) (ss - 3));
+      dd[-1] = ss[-1];
+      break;
+
+    case 100:
+      memcpy_sse2_64(dd - 100, ss - 100);
+    case 36:
+      memcpy_sse2_32(dd - 36, ss - 36);
+      *((uint32_t*) (dd - 4)) = *((uint32_t*) (ss - 4));
+      break;
+
+    case 101:
+      memcpy_sse2_64(dd - 101, ss - 101);
+    case 37:
+      memcpy_sse2_32(dd - 37, ss - 37);
+      *((uint32_t*) (dd - 5)) = *((uint32_t*) (ss - 5));
+      dd[-1] = ss[-1];
+      break;
+
+    case 102:
+      memcpy_sse2_64(dd - 102, ss - 102);
+    case 38:
+      memcpy_sse2_32(dd - 38, ss - 38);
+      *((uint32_t*) (dd - 6)) = *((uint32_t*) (ss - 6));
+      *((uint16_t*) (dd - 2)) = *((uint16_t*) (ss - 2));
+      break;
+
+    case 103:
+      memcpy_sse2_64(dd - 103, ss - 103);
+    case 39:
+      memcpy_sse2_32(dd - 39, ss - 39);
+      *((uint32_t*) (dd - 7)) = *((uint32_t*) (ss - 7));
+      *((uint32_t*) (dd - 4)) = *((uint32_t*) (ss - 4));
+      break;
+
+    case 104:
+      memcpy_sse2_64(dd - 104, ss - 104);
+    case 40:
+      memcpy_sse2_32(dd - 40, ss - 40);
+      *((uint64_t*) (dd - 8)) = *((uint64_t*) (ss - 8));
+      break;
+
+    case 105:
+      memcpy_sse2_64(dd - 105, ss - 105);
+    case 41:
+      memcpy_sse2_32(dd - 41, ss - 41);
+      *((uint64_t*) (dd - 9)) = *((uint64_t*) (ss - 9));
+      dd[-1] = ss[-1];
+      break;
+
+    case 106:
+      memcpy_sse2_64(dd - 106, ss - 106);
+    case 42:
+      memcpy_sse2_32(dd - 42, ss - 42);
+      *((uint64_t*) (dd - 10)) = *((uint64_t*) (ss - 10));
+      *((uint16_t*) (dd - 2)) = *((uint16_t*) (ss - 2));
+      break;
+
+    case 107:
+      memcpy_sse2_64(dd - 107, ss - 107);
+    case 43:
+      memcpy_sse2_32(dd - 43, ss - 43);
+      *((uint64_t*) (dd - 11)) = *((uint64_t*) (ss - 11));
+      *((uint32_t*) (dd - 4)) = *((uint32_t*) (ss - 4));
+      break;
+
+    case 108:
+      memcpy_sse2_64(dd - 108, ss - 108);
+    case 44:
+      memcpy_sse2_32(dd - 44, ss - 44);
+      *((uint64_t*) (dd - 12)) = *((uint64_t*) (ss - 12));
+      *((uint32_t*) (dd - 4)) = *((uint32_t*) (ss - 4));
+      break;
+
+    case 109:
+      memcpy_sse2_64(dd - 109, ss - 109);
+    case 45:
+      memcpy_sse2_32(dd - 45, ss - 45);
+      *((uint64_t*) (dd - 13)) = *((uint64_t*) (ss - 13));
+      *((uint32_t*) (dd - 5)) = *((uint32_t*) (ss - 5));
+      dd[-1] = ss[-1];
+      break;
+
+    case 110:
+      memcpy_sse2_64(dd - 110, ss - 110);
+    case 46:
+      memcpy_sse2_32(dd - 46, ss - 46);
+      *((uint64_t*) (dd - 14)) = *((uint64_t*) (ss - 14));
+      *((uint64_t*) (dd - 8)) = *((uint64_t*) (ss - 8));
+      break;
+
+    case 111:
+      memcpy_sse2_64(dd - 111, ss - 111);
+    case 47:
+      memcpy_sse2_32(dd - 47, ss - 47);
+      *((uint64_t*) (dd - 15)) = *((uint64_t*) (ss - 15));
+      *((uint64_t*) (dd - 8)) = *((uint64_t*) (ss - 8));
+      break;
+
+    case 112:
+      memcpy_sse2_64(dd - 112, ss - 112);
+    case 48:
+      memcpy_sse2_32(dd - 48, ss - 48);
+      memcpy_sse2_16(dd - 16, ss - 16);
+      break;
+
+    case 113:
+      memcpy_sse2_64(dd - 113, ss - 113);
+    case 49:
+      memcpy_sse2_32(dd - 49, ss - 49);
+      memcpy_sse2_16(dd - 17, ss - 17);
+      dd[-1] = ss[-1];
+      break;
+
+    case 114:
+      memcpy_sse2_64(dd - 114, ss - 114);
+    case 50:
+      memcpy_sse2_32(dd - 50, ss - 50);
+      memcpy_sse2_16(dd - 18, ss - 18);
+      *((uint16_t*) (dd - 2)) = *((uint16_t*) (ss - 2));
+      break;
+
+    case 115:
+      memcpy_sse2_64(dd - 115, ss - 115);
+    case 51:
+      memcpy_sse2_32(dd - 51, ss - 51);
+      memcpy_sse2_16(dd - 19, ss - 19);
+      *((uint16_t*) (dd - 3)) = *((uint16_t*) (ss - 3));
+      dd[-1] = ss[-1];
+      break;
+
+    case 116:
+      memcpy_sse2_64(dd - 116, ss - 116);
+    case 52:
+      memcpy_sse2_32(dd - 52, ss - 52);
+      memcpy_sse2_16(dd - 20, ss - 20);
+      *((uint32_t*) (dd - 4)) = *((uint32_t*) (ss - 4));
+      break;
+
+    case 117:
+      memcpy_sse2_64(dd - 117, ss - 117);
+    case 53:
+      memcpy_sse2_32(dd - 53, ss - 53);
+      memcpy_sse2_16(dd - 21, ss - 21);
+      *((uint32_t*) (dd - 5)) = *((uint32_t*) (ss - 5));
+      dd[-1] = ss[-1];
+      break;
+
+    case 118:
+      memcpy_sse2_64(dd - 118, ss - 118);
+    case 54:
+      memcpy_sse2_32(dd - 54, ss - 54);
+      memcpy_sse2_16(dd - 22, ss - 22);
+      *((uint32_t*) (dd - 6)) = *((uint32_t*) (ss - 6));
+      *((uint16_t*) (dd - 2)) = *((uint16_t*) (ss - 2));
+      break;
+
+    case 119:
+      memcpy_sse2_64(dd - 119, ss - 119);
+    case 55:
+      memcpy_sse2_32(dd - 55, ss - 55);
+      memcpy_sse2_16(dd - 23, ss - 23);
+      *((uint32_t*) (dd - 7)) = *((uint32_t*) (ss - 7));
+      *((uint32_t*) (dd - 4)) = *((uint32_t*) (ss - 4));
+      break;
+
+    case 120:
+      memcpy_sse2_64(dd - 120, ss - 120);
+    case 56:
+      memcpy_sse2_32(dd - 56, ss - 56);
+      memcpy_sse2_16(dd - 24, ss - 24);
+      memcpy_sse2_16(dd - 16, ss - 16);
+      break;
+
+    case 121:
+      memcpy_sse2_64(dd - 121, ss - 121);
+    case 57:
+      memcpy_sse2_32(dd - 57, ss - 57);
+      memcpy_sse2_16(dd - 25, ss - 25);
+      memcpy_sse2_16(dd - 16, ss - 16);
+      break;
+
+    case 122:
+      memcpy_sse2_64(dd - 122, ss - 122);
+    case 58:
+      memcpy_sse2_32(dd - 58, ss - 58);
+      memcpy_sse2_16(dd - 26, ss - 26);
+      memcpy_sse2_16(dd - 16, ss - 16);
+      break;
+
+    case 123:
+      memcpy_sse2_64(dd - 123, ss - 123);
+    case 59:
+      memcpy_sse2_32(dd - 59, ss - 59);
+      memcpy_sse2_16(dd - 27, ss - 27);
+      memcpy_sse2_16(dd - 16, ss - 16);
+      break;
+
+    case 124:
+      memcpy_sse2_64(dd - 124, ss - 124);
+    case 60:
+      memcpy_sse2_32(dd - 60, ss - 60);
+      memcpy_sse2_16(dd - 28, ss - 28);
+      memcpy_sse2_16(dd - 16, ss - 16);
+      break;
+
+    case 125:
+      memcpy_sse2_64(dd - 125, ss - 125);
+    case 61:
+      memcpy_sse2_32(dd - 61, ss - 61);
+      memcpy_sse2_16(dd - 29, ss - 29);
+      memcpy_sse2_16(dd - 16, ss - 16);
+      break;
+
+    case 126:
+      memcpy_sse2_64(dd - 126, ss - 126);
+    case 62:
+      memcpy_sse2_32(dd - 62, ss - 62);
+      memcpy_sse2_16(dd - 30, ss - 30);
+      memcpy_sse2_16(dd - 16, ss - 16);
+      break;
+
+    case 127:
+      memcpy_sse2_64(dd - 127, ss - 127);
+    case 63:
+      memcpy_sse2_32(dd - 63, ss - 63);
+      memcpy_sse2_16(dd - 31, ss - 31);
+      memcpy_sse2_16(dd - 16, ss - 16);
+      break;
+
+    case 128:
+      memcpy_sse2_128(dd - 128, ss - 128);
+      break;
+  }
+
+  return dst;
+}
+
+//---------------------------------------------------------------------
+// main routine
+//---------------------------------------------------------------------
+static void* memcpy_fast(void *destination, const void *source, size_t size)
+{
+  unsigned char *dst = (unsigned char*) destination;
+  const unsigned char *src = (const unsigned char*) source;
+  static size_t cachesize = 0x200000; // L2-cache size
+  size_t padding;
+
+  // small memory copy
+  if (size <= 128)
+  {
+    return memcpy_tiny(dst, src, size);
+  }
+
+  // align destination to 16 bytes boundary
+  padding = (16 - (((size_t) dst) & 15)) & 15;
+
+  if (padding > 0)
+  {
+    __m128i head = _mm_loadu_si128((const __m128i *) src);
+    _mm_storeu_si128((__m128i *) dst, head);
+    dst += padding;
+    src += padding;
+    size -= padding;
+  }
+
+  // medium size copy
+  if (size <= cachesize)
+  {
+    __m128i c0, c1, c2, c3, c4, c5, c6, c7;
+
+    for (; size >= 128; size -= 128)
+    {
+      c0 = _mm_loadu_si128(((const __m128i *) src) + 0);
+      c1 = _mm_loadu_si128(((const __m128i *) src) + 1);
+      c2 = _mm_loadu_si128(((const __m128i *) src) + 2);
+      c3 = _mm_loadu_si128(((const __m128i *) src) + 3);
+      c4 = _mm_loadu_si128(((const __m128i *) src) + 4);
+      c5 = _mm_loadu_si128(((const __m128i *) src) + 5);
+      c6 = _mm_loadu_si128(((const __m128i *) src) + 6);
+      c7 = _mm_loadu_si128(((const __m128i *) src) + 7);
+      _mm_prefetch((const char* )(src + 256), _MM_HINT_NTA);
+      src += 128;
+      _mm_store_si128((((__m128i *) dst) + 0), c0);
+      _mm_store_si128((((__m128i *) dst) + 1), c1);
+      _mm_store_si128((((__m128i *) dst) + 2), c2);
+      _mm_store_si128((((__m128i *) dst) + 3), c3);
+      _mm_store_si128((((__m128i *) dst) + 4), c4);
+      _mm_store_si128((((__m128i *) dst) + 5), c5);
+      _mm_store_si128((((__m128i *) dst) + 6), c6);
+      _mm_store_si128((((__m128i *) dst) + 7), c7);
+      dst += 128;
+    }
+  }
+  else
+  {   // big memory copy
+    __m128i c0, c1, c2, c3, c4, c5, c6, c7;
+
+    _mm_prefetch((const char* )(src), _MM_HINT_NTA);
+
+    if ((((size_t) src) & 15) == 0)
+    { // source aligned
+      for (; size >= 128; size -= 128)
+      {
+        c0 = _mm_load_si128(((const __m128i *) src) + 0);
+        c1 = _mm_load_si128(((const __m128i *) src) + 1);
+        c2 = _mm_load_si128(((const __m128i *) src) + 2);
+        c3 = _mm_load_si128(((const __m128i *) src) + 3);
+        c4 = _mm_load_si128(((const __m128i *) src) + 4);
+        c5 = _mm_load_si128(((const __m128i *) src) + 5);
+        c6 = _mm_load_si128(((const __m128i *) src) + 6);
+        c7 = _mm_load_si128(((const __m128i *) src) + 7);
+        _mm_prefetch((const char* )(src + 256), _MM_HINT_NTA);
+        src += 128;
+        _mm_stream_si128((((__m128i *) dst) + 0), c0);
+        _mm_stream_si128((((__m128i *) dst) + 1), c1);
+        _mm_stream_si128((((__m128i *) dst) + 2), c2);
+        _mm_stream_si128((((__m128i *) dst) + 3), c3);
+        _mm_stream_si128((((__m128i *) dst) + 4), c4);
+        _mm_stream_si128((((__m128i *) dst) + 5), c5);
+        _mm_stream_si128((((__m128i *) dst) + 6), c6);
+        _mm_stream_si128((((__m128i *) dst) + 7), c7);
+        dst += 128;
+      }
+    }
+    else
+    {             // source unaligned
+      for (; size >= 128; size -= 128)
+      {
+        c0 = _mm_loadu_si128(((const __m128i *) src) + 0);
+        c1 = _mm_loadu_si128(((const __m128i *) src) + 1);
+        c2 = _mm_loadu_si128(((const __m128i *) src) + 2);
+        c3 = _mm_loadu_si128(((const __m128i *) src) + 3);
+        c4 = _mm_loadu_si128(((const __m128i *) src) + 4);
+        c5 = _mm_loadu_si128(((const __m128i *) src) + 5);
+        c6 = _mm_loadu_si128(((const __m128i *) src) + 6);
+        c7 = _mm_loadu_si128(((const __m128i *) src) + 7);
+        _mm_prefetch((const char* )(src + 256), _MM_HINT_NTA);
+        src += 128;
+        _mm_stream_si128((((__m128i *) dst) + 0), c0);
+        _mm_stream_si128((((__m128i *) dst) + 1), c1);
+        _mm_stream_si128((((__m128i *) dst) + 2), c2);
+        _mm_stream_si128((((__m128i *) dst) + 3), c3);
+        _mm_stream_si128((((__m128i *) dst) + 4), c4);
+        _mm_stream_si128((((__m128i *) dst) + 5), c5);
+        _mm_stream_si128((((__m128i *) dst) + 6), c6);
+        _mm_stream_si128((((__m128i *) dst) + 7), c7);
+        dst += 128;
+      }
+    }
+    _mm_sfence();
+  }
+
+  memcpy_tiny(dst, src, size);
+
+  return destination;
+}
+#endif
@@ -1,73 +1,121 @@
-#ifndef MY_MD5_H_
-#define MY_MD5_H_
-
-#include <string>
-#include <iostream>
-
-#include "geco-common.h"
-#include "geco-net-config.h"
-
-/**
-* CRC32Ϊ32bit�ļ�hash��MD5Ϊ128bit�ϸ��ӵ�hash�㷨��
-* ֱ����ò��CRC32�ļ����ٶ�Ҫ��MD5��ġ�
-* ������FlexHEX������ļ���hashʱ����CRC32���MD5��û���������ơ�
-* ʵ�鷢�֣�Linux����ϵͳ����md5sum��cksumȡ�ļ���ϣ��MD5������CRC32ʱ���72%���ҡ�
-* MD5�����ٶ�Ҫ��������CRC32��
-* SHAϵ���㷨��ժҪ���ȷֱ�Ϊ��
-* SHAΪ20�ֽڣ�160λ����SHA256Ϊ32�ֽڣ�256λ, SHA384Ϊ48�ֽڣ�384λ����SHA512Ϊ64�ֽڣ�512λ����
-* ����������������ժҪ�ĳ��ȸ�������˸����Է�����ײ�����Ҳ��Ϊ��ȫ������δ������ժҪ�㷨�ķ�չ����
-* ����SHAϵ���㷨������ժҪ���Ƚϳ�������������ٶ���MD5��ȣ�Ҳ��Խ�����
-* ĿǰSHA1��Ӧ�ý�Ϊ�㷺����ҪӦ����CA������֤���У�
-* ������Ŀǰ�����������е�BT����У�Ҳ��ʹ��SHA1�������ļ�У��ġ�
-*/
-
-#undef   SHA20_HMAC
-#undef   SHA32_HMAC
-#undef   SHA48_HMAC
-#undef   SHA64_HMAC
-
-#if defined(MD5_HMAC)
-#define  HMAC_LEN   16 /* 16 bytes == 128 Bits == 4 doublewords */
-#elif defined(SHA20_HMAC)
-#define  HMAC_LEN   20 /* 20 bytes == 160 Bits == 5 doublewords */
-#elif defined(SHA32_HMAC)
-#define  HMAC_LEN   32
-#elif defined(SHA48_HMAC)
-#define  HMAC_LEN   48
-#elif defined(SHA64_HMAC)
-#define  HMAC_LEN   64
-#endif
-
-#define SECRET_KEYSIZE  4096
-#define KEY_INIT     0
-#ifndef KEY_READ
-#define KEY_READ     1
-#endif
-#define MAX_DEST    16
-
-extern void(*gset_checksum)(char *buffer, int length);
-extern int(*gvalidate_checksum)(char *buffer, int length);
-
-extern int validate_md5_checksum(char *buffer, int length);
-extern void set_md5_checksum(char *buffer, int length);
-
-extern void set_crc32_checksum(char *buffer, int length);
-extern int validate_crc32_checksum(char* buffer, int len);
-
-extern uint generate_random_uint32();
-extern const char* hexdigest(uchar data[], int lenbytes);
-extern uchar* get_secre_key(int operation_code);
-
-/* MD5 context. */
-typedef struct
-{
-	unsigned int state[4]; /* state (ABCD) */
-	unsigned int count[2]; /* number of bits, modulo 2^64 (lsb first) */
-	unsigned char buffer[64]; /* input buffer */
-} MD5_CTX;
-extern void MD5Init(MD5_CTX *);
-extern void MD5Update(MD5_CTX *, unsigned char * src, unsigned int len);
-extern void MD5Final(unsigned char dest_digest[16], MD5_CTX * ctx);
-extern unsigned int generate_md5_checksum(const void *data, int length);
-#endif
-
+#ifndef MY_MD5_H_
+#define MY_MD5_H_
+
+#include <string>
+#include <iostream>
+
+#include "geco-common.h"
+#include "geco-net-config.h"
+
+/**
+* CRC32Ϊ32bit�ļ�hash��MD5Ϊ128bit�ϸ��ӵ�hash�㷨��
+* ֱ����ò��CRC32�ļ����ٶ�Ҫ��MD5��ġ�
+* ������FlexHEX������ļ���hashʱ����CRC32���MD5��û���������ơ�
+* ʵ�鷢�֣�Linux����ϵͳ����md5sum��cksumȡ�ļ���ϣ��MD5������CRC32ʱ���72%���ҡ�
+* MD5�����ٶ�Ҫ��������CRC32��
+* SHAϵ���㷨��ժҪ���ȷֱ�Ϊ��
+* SHAΪ20�ֽڣ�160λ����SHA256Ϊ32�ֽڣ�256λ, SHA384Ϊ48�ֽڣ�384λ����SHA512Ϊ64�ֽڣ�512λ����
+* ����������������ժҪ�ĳ��ȸ�������˸����Է�����ײ�����Ҳ��Ϊ��ȫ������δ������ժҪ�㷨�ķ�չ����
+* ����SHAϵ���㷨������ժҪ���Ƚϳ�������������ٶ���MD5��ȣ�Ҳ��Խ�����
+* ĿǰSHA1��Ӧ�ý�Ϊ�㷺����ҪӦ����CA������֤���У�
+* ������Ŀǰ�����������е�BT����У�Ҳ��ʹ��SHA1�������ļ�У��ġ�
+*/
+
+#undef   SHA20_HMAC
+#undef   SHA32_HMAC
+#undef   SHA48_HMAC
+#undef   SHA64_HMAC
+
+#if defined(MD5_HMAC)
+#define  HMAC_LEN   16 /* 16 bytes == 128 Bits == 4 doublewords */
+#elif defined(SHA20_HMAC)
+#define  HMAC_LEN   20 /* 20 bytes == 160 Bits == 5 doublewords */
+#elif defined(SHA32_HMAC)
+#define  HMAC_LEN   32
+#elif defined(SHA48_HMAC)
+#define  HMAC_LEN   48
+#elif defined(SHA64_HMAC)
+#define  HMAC_LEN   64
+#endif
+
+#define SECRET_KEYSIZE  4096
+#define KEY_INIT     0
+#ifndef KEY_READ
+#define KEY_READ     1
+#endif
+#define MAX_DEST    16
+
+extern void(*gset_checksum)(char *buffer, int length);
+extern int(*gvalidate_checksum)(char *buffer, int length);
+
+extern int validate_md5_checksum(char *buffer, int length);
+extern void set_md5_checksum(char *buffer, int length);
+
+extern void set_crc32_checksum(char *buffer, int length);
+extern int validate_crc32_checksum(char* buffer, int len);
+
+/**
+ * incremental crc32c, used by the bundler to checksum chunks while they are
+ * copied into the bundle buffers so the send path needs no second pass.
+ * crc32c_update() continues @crc (0 for a new run) over @len bytes,
+ * crc32c_copy() does the same while copying @src to @dest and
+ * crc32c_combine() returns the crc of A|B from crc(A), crc(B) and len(B).
+ */
+extern uint crc32c_update(uint crc, const void* buf, uint len);
+extern uint crc32c_copy(void* dest, const void* src, uint len, uint crc);
+extern uint crc32c_combine(uint crc1, uint crc2, uint len2);
+/// same as set_crc32_checksum() but only hashes the first @hdr_len bytes,
+/// the following @chunks_len bytes are covered by the precomputed @chunks_crc
+extern void set_crc32_checksum_fused(char *buffer, int hdr_len, uint chunks_crc,
+    int chunks_len);
+
+/// fast per-thread PRNG (xoshiro128**) seeded from the os entropy pool,
+/// used for tags, ports and tsns. NOT for key material.
+extern uint generate_random_uint32();
+/// fills @buf from the os csprng (getrandom(), /dev/urandom or rand_s()),
+/// returns false if none of them is available
+extern bool get_random_bytes(void* buf, uint len);
+
+/**
+ * state cookies are signed with SipHash-2-4 (128 bits output fills the 16 bytes
+ * cookie hmac field) under a 16 bytes secret which is replaced every
+ * COOKIE_SECRET_ROTATE_MS. the replaced secret stays valid until the next
+ * rotation, so keep COOKIE_SECRET_ROTATE_MS >= the longest cookie life
+ * (VALID_COOKIE_LIFE_TIME) to never reject a cookie signed right before a rotation.
+ */
+#define COOKIE_KEY_SIZE 16
+#define COOKIE_MAC_LEN 16
+#define COOKIE_SECRET_ROTATE_MS 120000
+extern void siphash24_128(const uchar key[16], const void* data, uint len, uchar out[16]);
+extern void sign_cookie(const void* cookie, uint len, uchar mac[COOKIE_MAC_LEN]);
+/// checks @mac against the current and, if any, the previous secret
+extern bool verify_cookie(const void* cookie, uint len, const uchar mac[COOKIE_MAC_LEN]);
+/// replaces the current secret, called by sign_cookie()/verify_cookie() when due
+extern void rotate_cookie_secret();
+/**
+ * resumption tickets outlive any cookie, so they have their own secret which is replaced
+ * every RESUME_TICKET_SECRET_ROTATE_MS and, like the cookie secret, stays valid until the
+ * next rotation. ticket lifetimes are clamped to it, a ticket verifies for its whole life.
+ */
+#define RESUME_TICKET_SECRET_ROTATE_MS 600000
+extern void sign_resume_ticket(const void* ticket, uint len, uchar mac[COOKIE_MAC_LEN]);
+/// checks @mac against the current and, if any, the previous ticket secret
+extern bool verify_resume_ticket(const void* ticket, uint len, const uchar mac[COOKIE_MAC_LEN]);
+/// replaces the current ticket secret, called by sign_resume_ticket()/verify_resume_ticket() when due
+extern void rotate_resume_ticket_secret();
+extern const char* hexdigest(uchar data[], int lenbytes);
+extern uchar* get_secre_key(int operation_code);
+
+/* MD5 context. */
+typedef struct
+{
+	unsigned int state[4]; /* state (ABCD) */
+	unsigned int count[2]; /* number of bits, modulo 2^64 (lsb first) */
+	unsigned char buffer[64]; /* input buffer */
+} MD5_CTX;
+extern void MD5Init(MD5_CTX *);
+extern void MD5Update(MD5_CTX *, unsigned char * src, unsigned int len);
+extern void MD5Final(unsigned char dest_digest[16], MD5_CTX * ctx);
+extern unsigned int generate_md5_checksum(const void *data, int length);
+#endif
+
@@ -31,9 +31,22 @@
 
 #include "geco-net-common.h"
 #include "geco-malloc.h"
+#include "geco-ds-slot-map.h"
+#include "geco-net-lz.h"
 #include "geco-net.h"
+#include "wheel-timer.h"
 
-struct timeout;
+/**
+ * keeps the armed protocol timers of a channel (sack, t3, heartbeat and init timers) and
+ * registers only the earliest deadline with the wheel. the wheel entry only ever moves
+ * earlier, when it goes off the due timer is fired and the entry moves to the next deadline
+ */
+struct timer_mux_t
+{
+	timeout wheel;
+	timeout* timers[TIMER_MUX_MAX_TIMERS]; // armed timers in no order
+	uint num;
+};
 
 /**
  * This struct stores data of geco_instance_t.
@@ -93,7 +106,7 @@ struct geco_instance_t
  * when data chunk presents AND NO sack AND ctrl chunks,
  * we use data_buf and nothing to bundle.
  */
-struct bundle_controller_t
+struct bundle_buffers_t
 {
 	/** buffer for control chunks */
 	char ctrl_buf[MAX_GECO_PACKET_SIZE];
@@ -101,6 +114,12 @@ struct bundle_controller_t
 	char sack_buf[MAX_GECO_PACKET_SIZE];
 	/** buffer for data chunks */
 	char data_buf[MAX_GECO_PACKET_SIZE];
+};
+struct bundle_controller_t
+{
+	/** borrowed from the per thread pool by mbu_borrow_buffers() when the first chunk is
+	 * bundled and returned once the packet is sent, NULL while nothing is bundled */
+	bundle_buffers_t* buffers;
 	/* Leave some space for the SCTP common header */
 	/**  current position in the buffer for control chunks */
 	uint ctrl_position;
@@ -126,9 +145,18 @@ struct bundle_controller_t
 	uint requested_destination;
 	uint geco_packet_fixed_size;
 	uint curr_max_pdu;
+	/** running crc32c of the chunks copied into each buffer (fixed header excluded),
+	 * only trusted while xxx_crc_len == xxx_position - geco_packet_fixed_size */
+	uint ctrl_crc;
+	uint sack_crc;
+	uint data_crc;
+	uint ctrl_crc_len;
+	uint sack_crc_len;
+	uint data_crc_len;
 
 	bundle_controller_t()
 	{
+		buffers = NULL;
 		reset();
 	}
 	void reset()
@@ -139,6 +167,8 @@ struct bundle_controller_t
 		got_shutdown = locked = got_send_address = got_send_request = data_in_buffer = ctrl_chunk_in_buffer =
 			sack_in_buffer = false;
 		curr_max_pdu = 0;
+		ctrl_crc = sack_crc = data_crc = 0;
+		ctrl_crc_len = sack_crc_len = data_crc_len = 0;
 	}
 };
 
@@ -155,7 +185,8 @@ struct recv_controller_t
 	bool new_dchunk_received; /*indicates whether a received dchunk is truly new */
 	bool datagram_has_new_dchunk; /*indicates whether a received datagram contains  new dchunk(s)*/
 	bool datagram_has_reliable_dchunk; /*indicates whether a received datagram contains  new reliable dchunk(s)*/
-	timeout* sack_timer; /* timer for delayed sacks */
+	timeout sack_timer; /* timer for delayed sacks, armed in place */
+	int sack_path; /* path the delayed sack goes back on, arg2 of sack_timer */
 	int dchunk_datagram_counter;
 	uint sack_flag; /* 1 (sack each data chunk) or 2 (sack every second chunk)*/
 	uint remote_addr_idx;
@@ -204,8 +235,8 @@ struct path_params_t
 	uint pmtu;
 	// mtu that not acked but rescheduled test again
 	uint probing_pmtu;
-	// id of hb timer
-	timeout* hb_timer_id;
+	// hb timer, armed in place
+	timeout hb_timer;
 	//used to detect multiple tx of dchunk in last rto span
 	uint64 rto_update;
 	//search_low          eff_pmtu         search_high
@@ -246,6 +277,13 @@ struct path_controller_t
 	//maximum RTO, a configurable parameter
 	uint rto_max;
 	uint min_pmtu;
+	/* address migration: a packet carrying our tag came from an address this channel does not know,
+	 * e.g. after a NAT rebinding. the address replaces migration_path once a heartbeat sent to it is
+	 * acked from it. migration_path is -1 when no migration is pending */
+	sockaddrunion migration_addr;
+	int migration_path;
+	uint migration_probe_time;
+	bool migration_mapped; /* the probe added migration_addr to path_map, it is erased when the probe ends */
 };
 
 /// state controller structure. Stores the current state of the channel.
@@ -253,8 +291,8 @@ struct smctrl_t
 {
 	/** the state of this state machine */
 	ChannelState channel_state;
-	/** stores timer-ID of init/cookie-timer, used to stop this timer */
-	timeout* init_timer_id;
+	/** init/cookie/shutdown timer, its callback type tells which one is running */
+	timeout init_timer;
 	/** */
 	uint init_timer_interval;
 	/**  stores the channel id (==tag) of this association */
@@ -316,7 +354,8 @@ struct reltransfer_controller_t
 	//ordered by ascending tsn
 	std::list<internal_data_chunk_t*> chunk_list_tsn_ascended;
 	std::vector<internal_data_chunk_t*> prChunks;
-	internal_data_chunk_t *rtx_chunks[RTX_CHUNK_MAX_SIZE];
+	/// RTX_CHUNK_MAX_SIZE slots allocated on the first sack that acks or retransmits chunks
+	internal_data_chunk_t **rtx_chunks;
 };
 
 /// this struct contains all relevant congestion control parameters for
@@ -342,7 +381,7 @@ struct flow_controller_t
 	std::list<internal_data_chunk_t*> chunk_list;
 	uint list_length;
 	// one timer may be running per destination address
-	timeout** T3_timer;
+	timeout* T3_timer;
 	// for passing as parameter in callback functions
 	uint *addresses;
 	uint channel_id;
@@ -364,10 +403,11 @@ struct delivery_data_t
 	uint tsn;
 	uint from_addr_index;
 	uchar chunk_flags;
-	uchar data[MAX_NETWORK_PACKET_VALUE_SIZE]; // usr data this is assigned from data chunk value
+	uchar data[1]; // usr data copied from data chunk value, sized to data_length when allocated
 	//bool can_free_at_once; //this is aseembled chunk we can delete for efficiency
    // void* packet_params_t; // where this chunk is located
 };
+#define DELIVERY_DATA_FIXED_SIZE offsetof(delivery_data_t, data)
 
 /// stores several chunks that can be delivered to the user as one message
 struct delivery_pdu_t
@@ -398,6 +438,13 @@ struct recv_stream_t  //ReceiveStream
 	int index;
 };
 
+/// adaptive bypass of the compression of messages that do not compress
+struct lz_bypass_t
+{
+	ushort poor_msgs; // poor compression results in a row
+	ushort skip_msgs; // messages left to send raw without trying
+};
+
 struct send_stream_t  //SendStream
 {
 	unsigned int nextSSN;
@@ -416,6 +463,8 @@ struct deliverman_controller_t
 	uint queued_bytes;
 	bool unreliable;
 	bool unordered;
+	bool compress_msgs;
+	lz_bypass_t lz_bypass;
 	// reliable unordered(r), reliable&ordered(ro), reliable&sequenced(rs),
 	// unreliable unordered(u), unreliable&ordered(uro) or unreliable&sequenced(urs)
 	// parse packet and put dchunk to againest list, they must be ordered
@@ -440,7 +489,7 @@ struct geco_channel_t
 	 it is used as a key to find a channel in the list,
 	 and never changes in the  live of the channel */
 	uint channel_id;
-	uint local_tag; /*The local tag of this channel*/
+	uint local_tag; /*The local tag of this channel, indexed in tag_map_*/
 	uint remote_tag; /*The tag of remote side of this channel*/
 	/*Pointer to the geco-instance this association belongs to.
 	 It is equal to the assignated port number of the ULP that uses this instance*/
@@ -466,6 +515,8 @@ struct geco_channel_t
 	path_controller_t *path_control;
 	bundle_controller_t *bundle_control;
 	smctrl_t *state_machine_control;
+	/* the one wheel entry of all protocol timers of the controllers above */
+	timer_mux_t timers;
 	/* do I support the DCTP extensions ? */
 	bool locally_supported_PRDCTP;
 	bool locally_supported_ADDIP;
@@ -476,6 +527,54 @@ struct geco_channel_t
 	void * ulp_dataptr; /* transparent pointer to some upper layer data */
 };
 
+/**
+ * a channel and its fixed size controllers are co-allocated in one block by mdi_new_channel(),
+ * so an idle channel costs one allocation plus its address and stream arrays.
+ * bundle, path and sm controllers are set up by mdi_new_channel(), the rest are constructed
+ * in place by mdi_init_channel() and destructed by their xxx_free(), the block itself is
+ * freed by mdi_delete_curr_channel()
+ */
+struct channel_arena_t
+{
+	geco_channel_t channel;
+	bundle_controller_t bundle;
+	path_controller_t path;
+	smctrl_t smctrl;
+	alignas(flow_controller_t) char flow[sizeof(flow_controller_t)];
+	alignas(reltransfer_controller_t) char reltx[sizeof(reltransfer_controller_t)];
+	alignas(recv_controller_t) char recv[sizeof(recv_controller_t)];
+	alignas(deliverman_controller_t) char dlm[sizeof(deliverman_controller_t)];
+};
+#define channel_arena_of(channel) ((channel_arena_t*)(channel))
+
+/**
+ * the state of the event the dispatcher is handling: the instance, channel and packet
+ * addressed by a ULP call, socket event or timer event, set up when the event comes in
+ * and reset when it has been handled. each network thread has its own, so stacks run
+ * on different threads share none of it.
+ */
+struct dispatch_context_t
+{
+	/// the instance addressed by the event, NULL once it has been handled
+	geco_instance_t* curr_geco_instance;
+	/// the channel addressed by the event, NULL once it has been handled
+	geco_channel_t* curr_channel;
+
+	/// the packet being received
+	geco_packet_fixed_t* curr_geco_packet_fixed;
+	geco_packet_t* curr_geco_packet;
+	uint curr_geco_packet_value_len;
+	sockaddrunion* last_source_addr;
+	sockaddrunion* last_dest_addr;
+	/// index of last_source_addr in the remote addr list of curr_channel, set by cmp_channel()
+	int last_src_path;
+	ushort last_src_port;
+	ushort last_dest_port;
+	uint last_init_tag;
+	uint last_veri_tag;
+};
+extern thread_local dispatch_context_t mdi_ctx_;
+
 /**
  *  recv_geco_packet
  *  recv_geco_packet is the callback function of the DCTP-message dispatch_layer.
@@ -495,4 +594,16 @@ struct geco_channel_t
 extern int mdi_recv_geco_packet(int socket_fd, char *dctp_packet, uint dctp_packet_len, sockaddrunion * source_addr,
 	sockaddrunion * dest_addr);
 
+/**
+ *  runs the operations other threads submitted with mulp_submit(), called by mtra_poll()
+ *  first thing in each iteration
+ */
+extern void mdi_drain_submissions();
+
+/**
+ *  hands the messages collected since the last call to the callback set with
+ *  mulp_set_data_arrive_batch_cb(), called by mtra_poll() last thing in each iteration
+ */
+extern void mdi_flush_data_arrivals();
+
 #endif
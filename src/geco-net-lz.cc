@@ -0,0 +1,245 @@
+/*
+ * geco-net-lz.cc
+ *
+ *  lzf format message compression with sliding dictionaries kept across messages
+ */
+
+#include <string.h>
+#include "geco-net-lz.h"
+
+#define LZ_HASH(p) \
+  ((((uint)(p)[0] << 16 | (uint)(p)[1] << 8 | (uint)(p)[2]) * 2654435761u) >> (32 - LZ_HASH_LOG))
+
+/// encoder of the messages compressed without a window of their own, forgets all of them
+/// before each message by moving its base past every position in its hash table
+static thread_local lz_encoder_t scratch_encoder_;
+
+void lz_window_init(lz_window_t* window)
+{
+  window->base = 0;
+  window->len = 0;
+}
+
+void lz_encoder_init(lz_encoder_t* enc)
+{
+  lz_window_init(&enc->window);
+  memset(enc->htab, 0, sizeof(enc->htab));
+}
+
+/// makes room for @len <= LZ_WINDOW_SIZE more bytes, keeping the last LZ_WINDOW_SIZE ones
+static inline void lz_window_reserve(lz_window_t* window, uint len)
+{
+  if (window->len + len > sizeof(window->buf))
+  {
+    uint drop = window->len - LZ_WINDOW_SIZE;
+    memmove(window->buf, window->buf + drop, LZ_WINDOW_SIZE);
+    window->base += drop;
+    window->len = LZ_WINDOW_SIZE;
+  }
+}
+
+void lz_window_append(lz_window_t* window, const uchar* msg, uint len)
+{
+  // only the last LZ_WINDOW_SIZE bytes can ever be referred to
+  if (len >= LZ_WINDOW_SIZE)
+  {
+    window->base += window->len + len - LZ_WINDOW_SIZE;
+    window->len = 0;
+    msg += len - LZ_WINDOW_SIZE;
+    len = LZ_WINDOW_SIZE;
+  }
+  lz_window_reserve(window, len);
+  memcpy(window->buf + window->len, msg, len);
+  window->len += len;
+}
+
+void lz_encoder_append(lz_encoder_t* enc, const uchar* msg, uint len)
+{
+  lz_window_append(&enc->window, msg, len);
+}
+
+static inline bool lz_emit_literals(const uchar* lit, const uchar* end, uchar** outp, uchar* out_end)
+{
+  uchar* op = *outp;
+  while (lit < end)
+  {
+    uint run = (uint) (end - lit);
+    if (run > LZ_MAX_LITERALS)
+      run = LZ_MAX_LITERALS;
+    if (run + 1 > (uint) (out_end - op))
+      return false;
+    *op++ = (uchar) (run - 1);
+    memcpy(op, lit, run);
+    op += run;
+    lit += run;
+  }
+  *outp = op;
+  return true;
+}
+
+/// compresses the @len <= LZ_WINDOW_SIZE bytes at @ip, the end of the window of @enc
+static bool lz_compress_piece(lz_encoder_t* enc, const uchar* ip, uint len, uchar** outp, uchar* out_end)
+{
+  lz_window_t* window = &enc->window;
+  const uchar* end = ip + len;
+  const uchar* lit = ip;
+  uchar* op = *outp;
+
+  while (ip + LZ_MIN_MATCH <= end)
+  {
+    uint hash = LZ_HASH(ip);
+    uint pos = window->base + (uint) (ip - window->buf);
+    uint cand = enc->htab[hash];
+    enc->htab[hash] = pos + 1;
+
+    // the candidate must still be in the window and within reach of the format
+    uint dist = pos - (cand - 1);
+    if (cand == 0 || cand - 1 < window->base || dist - 1 >= LZ_WINDOW_SIZE)
+    {
+      ip++;
+      continue;
+    }
+    const uchar* ref = ip - dist;
+    if (ref[0] != ip[0] || ref[1] != ip[1] || ref[2] != ip[2])
+    {
+      ip++;
+      continue;
+    }
+
+    uint maxlen = (uint) (end - ip);
+    if (maxlen > LZ_MAX_MATCH)
+      maxlen = LZ_MAX_MATCH;
+    uint mlen = LZ_MIN_MATCH;
+    while (mlen < maxlen && ref[mlen] == ip[mlen])
+      mlen++;
+
+    if (!lz_emit_literals(lit, ip, &op, out_end) || out_end - op < 3)
+      return false;
+    uint code = mlen - 2;
+    uint off = dist - 1;
+    if (code < 7)
+    {
+      *op++ = (uchar) ((code << 5) | (off >> 8));
+    }
+    else
+    {
+      *op++ = (uchar) ((7 << 5) | (off >> 8));
+      *op++ = (uchar) (code - 7);
+    }
+    *op++ = (uchar) off;
+
+    // the positions inside the match are candidates for the messages coming next
+    const uchar* match_end = ip + mlen;
+    for (ip++; ip + LZ_MIN_MATCH <= match_end; ip++)
+      enc->htab[LZ_HASH(ip)] = window->base + (uint) (ip - window->buf) + 1;
+    ip = lit = match_end;
+  }
+
+  if (!lz_emit_literals(lit, end, &op, out_end))
+    return false;
+  *outp = op;
+  return true;
+}
+
+uint lz_compress(lz_encoder_t* enc, const uchar* msg, uint len, uchar* out, uint cap)
+{
+  if (enc == NULL)
+  {
+    enc = &scratch_encoder_;
+    enc->window.base += enc->window.len;
+    enc->window.len = 0;
+  }
+  lz_window_t* window = &enc->window;
+  // rebase long before stream positions wrap, the hash table goes with the old base
+  if (window->base > 0x7fffffff)
+  {
+    window->base = 0;
+    memset(enc->htab, 0, sizeof(enc->htab));
+  }
+
+  uchar* op = out;
+  bool fits = true;
+  while (len > 0)
+  {
+    // a piece and the LZ_WINDOW_SIZE bytes it may refer to fit the window together
+    uint piece = len < LZ_WINDOW_SIZE ? len : LZ_WINDOW_SIZE;
+    lz_window_reserve(window, piece);
+    uchar* start = window->buf + window->len;
+    memcpy(start, msg, piece);
+    if (fits)
+      fits = lz_compress_piece(enc, start, piece, &op, out + cap);
+    window->len += piece;
+    msg += piece;
+    len -= piece;
+  }
+  return fits ? (uint) (op - out) : 0;
+}
+
+uint lz_decompress(lz_window_t* window, const uchar* in, uint len, uchar* out, uint cap)
+{
+  const uchar* ip = in;
+  const uchar* in_end = in + len;
+  uchar* op = out;
+  uchar* out_end = out + cap;
+  // distances beyond the output so far continue into the end of the window
+  const uchar* dict_end = window != NULL ? window->buf + window->len : NULL;
+  uint dict_len = window == NULL ? 0 : window->len < LZ_WINDOW_SIZE ? window->len : LZ_WINDOW_SIZE;
+
+  while (ip < in_end)
+  {
+    uint ctrl = *ip++;
+    if (ctrl < LZ_MAX_LITERALS)
+    {
+      uint run = ctrl + 1;
+      if (run > (uint) (in_end - ip) || run > (uint) (out_end - op))
+        return 0;
+      memcpy(op, ip, run);
+      op += run;
+      ip += run;
+      continue;
+    }
+
+    uint mlen = ctrl >> 5;
+    if (mlen == 7)
+    {
+      if (ip >= in_end)
+        return 0;
+      mlen += *ip++;
+    }
+    if (ip >= in_end)
+      return 0;
+    uint dist = ((ctrl & 0x1f) << 8) + *ip++ + 1;
+    mlen += 2;
+    if (mlen > (uint) (out_end - op))
+      return 0;
+
+    uint produced = (uint) (op - out);
+    if (dist > produced)
+    {
+      uint back = dist - produced;
+      if (back > dict_len)
+        return 0;
+      uint n = back < mlen ? back : mlen;
+      memcpy(op, dict_end - back, n);
+      op += n;
+      mlen -= n;
+    }
+    const uchar* ref = op - dist;
+    if (dist >= mlen)
+    {
+      memcpy(op, ref, mlen);
+      op += mlen;
+    }
+    else
+    {
+      // overlapping match repeating the last dist bytes
+      while (mlen-- > 0)
+        *op++ = *ref++;
+    }
+  }
+
+  len = (uint) (op - out);
+  if (window != NULL)
+    lz_window_append(window, out, len);
+  return len;
+}
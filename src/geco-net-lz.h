@@ -0,0 +1,61 @@
+/*
+ * geco-net-lz.h
+ *
+ *  lzf format message compression with sliding dictionaries kept across messages
+ */
+
+#ifndef __INCLUDE_GECO_NET_LZ_H
+#define __INCLUDE_GECO_NET_LZ_H
+
+#include "geco-common.h"
+
+/**
+ * the output is the lzf 3.6 format: a control byte below 32 is followed by that many
+ * plus one literals, otherwise its top 3 bits are the match length minus 2 (7 means
+ * an extra length byte follows) and its low 5 bits with the next byte are the match
+ * distance minus 1. a distance may reach back into the messages compressed before on
+ * the same window, so small repetitive game messages find their matches in the ones
+ * sent just before them. both ends must feed their window the same messages in the
+ * same order, compressed or not.
+ */
+#define LZ_WINDOW_SIZE 8192 // farthest distance of the lzf format
+#define LZ_MIN_MATCH 3
+#define LZ_MAX_MATCH 264
+#define LZ_MAX_LITERALS 32
+#define LZ_HASH_LOG 12
+/// output of lz_compress() never exceeds this for @len input bytes
+#define LZ_MAX_COMPRESSED_SIZE(len) ((len) + ((len) + LZ_MAX_LITERALS - 1) / LZ_MAX_LITERALS)
+
+/// the last LZ_WINDOW_SIZE bytes (at least) fed to a window, plus room to append one more
+/// LZ_WINDOW_SIZE piece before sliding
+struct lz_window_t
+{
+  uint base; // stream position of buf[0]
+  uint len;
+  uchar buf[2 * LZ_WINDOW_SIZE];
+};
+/// the sender side adds a hash table of stream positions to its window
+struct lz_encoder_t
+{
+  lz_window_t window;
+  uint htab[1 << LZ_HASH_LOG]; // stream position + 1 of the last 3 bytes with that hash
+};
+
+extern void lz_encoder_init(lz_encoder_t* enc);
+extern void lz_window_init(lz_window_t* window);
+
+/// compresses @len bytes of @msg into @out, matching against the window of @enc,
+/// or against @msg only when @enc is NULL
+/// @return compressed size, 0 if it would exceed @cap. the message is fed to the window either way
+extern uint lz_compress(lz_encoder_t* enc, const uchar* msg, uint len, uchar* out, uint cap);
+/// feeds a message sent uncompressed to the window of @enc so both ends stay in step
+extern void lz_encoder_append(lz_encoder_t* enc, const uchar* msg, uint len);
+
+/// decompresses @len bytes of @in into @out, resolving distances into the window, if any,
+/// and feeds the result to the window
+/// @return decompressed size, 0 if @in is malformed or the result would exceed @cap
+extern uint lz_decompress(lz_window_t* window, const uchar* in, uint len, uchar* out, uint cap);
+/// feeds a message received uncompressed to the window
+extern void lz_window_append(lz_window_t* window, const uchar* msg, uint len);
+
+#endif
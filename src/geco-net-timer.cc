@@ -1,146 +1,213 @@
-/*
- * gecotimer.cpp
- *
- *  Created on: 20 Apr 2016
- *      Author: jakez
- */
-
-#include "geco-ds-timer.h"
-
-timer_mgr::timer_mgr()
-{
-    this->tid = 1;
-}
-timer_mgr::~timer_mgr()
-{
-}
-timer_id_t timer_mgr::add_timer(uint timer_type,
-    time_t timeouts/*ms*/, timer::Action action, void *arg1, void *arg2)
-{
-    timer item;
-    if (gettimenow(&item.action_time) < 0)
-        return this->timers.end();
-
-    item.timer_id = this->tid++;
-    item.timer_type = timer_type;
-    sum_time(&item.action_time, timeouts, &item.action_time);
-    item.action = action;
-    item.arg1 = arg1;
-    item.arg2 = arg2;
-
-    if (item.timer_id == 0)
-    {
-        this->tid = 2;
-        item.timer_id = 1;
-    }
-
-    auto insert_pos = upper_bound(this->timers.begin(), this->timers.end(),
-        item, timer_mgr::cmp_timer_action_time);
-    this->timers.insert(insert_pos, item);
-    --insert_pos;
-    return insert_pos;
-}
-
-void timer_mgr::delete_timer(timer_id_t& timerptr)
-{
-    if (this->timers.empty())
-        return;
-    timerptr->timer_id = 0;
-    this->timers.erase(timerptr);
-}
-int timer_mgr::reset_timer(timer_id_t& timerptr, uint timeouts)
-{
-	EVENTLOG(VERBOSE, "reset_timer");
-	if (this->timers.empty())
-        return -1;
-    uint timer_type = timerptr->timer_type;
-    timer::Action action = timerptr->action;
-    void *arg1 = timerptr->arg1;
-    void *arg2 = timerptr->arg2;
-    delete_timer(timerptr);
-    timerptr = add_timer(timer_type, timeouts, action, arg1, arg2);
-    return 0;
-}
-int timer_mgr::timeouts()
-{
-	if (this->timers.empty())
-        return -1;
-
-    // get now and timeout
-    struct timeval now;
-    if (gettimenow(&now) < 0) return -1;
-
-    const struct timeval& timeout = this->timers.front().action_time;
-    int secs = timeout.tv_sec - now.tv_sec;
-    if (secs < 0) return 0; // sec timeouts
-
-	int usecs = timeout.tv_usec - now.tv_usec;
-    if (usecs < 0)
-    {
-        //as usecs has timeout, we need ti check if secs checkouts
-        //if  two secs equals, secs == 0, then must timeout
-        // if two secs difference greater than 1 sec, then must not timeout
-        secs--;
-        usecs += 1000000;
-    }
-
-    if (secs < 0) return 0; //secs timeouts
-
-    // no type overflow because number is very small
-    return ((int)(secs * 1000 + usecs / 1000));
-}
-
-
-void timer_mgr::print_timer(short event_log_level, const timer& item)
-{
-    const char* ttype;
-
-    switch (item.timer_type)
-    {
-        case TIMER_TYPE_INIT:
-            ttype = "Init Timer";
-            break;
-        case TIMER_TYPE_SACK:
-            ttype = "SACK Timer";
-            break;
-        case TIMER_TYPE_RTXM:
-            ttype = "T3 RTX Timer";
-            break;
-        case TIMER_TYPE_SHUTDOWN:
-            ttype = "Shutdown Timer";
-            break;
-        case TIMER_TYPE_CWND:
-            ttype = "CWND Timer";
-            break;
-        case TIMER_TYPE_HEARTBEAT:
-            ttype = "Heartbeat Timer";
-            break;
-        case TIMER_TYPE_USER:
-            ttype = "User Timer";
-            break;
-        default:
-            ttype = "Unknown Timer";
-            break;
-    }
-    EVENTLOG4(VVERBOSE,
-        "TimerID: %u, Type : %s, action_time: {%ld sec, %ld us}",
-        item.timer_id, ttype, item.action_time.tv_sec,
-        item.action_time.tv_usec);
-}
-void timer_mgr::print(short event_log_level)
-{
-    if (this->timers.size() == 0)
-    {
-        EVENTLOG(event_log_level, "No timers!");
-        return;
-    }
-    print_time_now(event_log_level);
-    EVENTLOG1(event_log_level, "lList Length : %ld", this->timers.size());
-    for (auto& timer : this->timers)
-    {
-        this->print_timer(event_log_level, timer);
-    }
-}
-
-
-
+/*
+ * gecotimer.cpp
+ *
+ *  Created on: 20 Apr 2016
+ *      Author: jakez
+ */
+
+#include "geco-ds-timer.h"
+
+timer_mgr::timer_mgr()
+{
+    this->tid = 1;
+    this->free_timers = NULL;
+}
+timer_mgr::~timer_mgr()
+{
+    for (size_t i = 0; i < this->pages.size(); i++)
+        delete[] this->pages[i];
+}
+void timer_mgr::sift_up(uint i)
+{
+    timer* item = this->heap[i];
+    while (i > 0)
+    {
+        uint parent = (i - 1) / TIMER_HEAP_ARITY;
+        if (!cmp_timer_action_time(*item, *this->heap[parent]))
+            break;
+        this->heap[i] = this->heap[parent];
+        this->heap[i]->heap_index = i;
+        i = parent;
+    }
+    this->heap[i] = item;
+    item->heap_index = i;
+}
+void timer_mgr::sift_down(uint i)
+{
+    timer* item = this->heap[i];
+    uint size = (uint) this->heap.size();
+    for (;;)
+    {
+        uint child = i * TIMER_HEAP_ARITY + 1;
+        if (child >= size)
+            break;
+        // earliest of up to TIMER_HEAP_ARITY children, all in one or two cache lines
+        uint last = child + TIMER_HEAP_ARITY < size ? child + TIMER_HEAP_ARITY : size;
+        uint min = child;
+        for (child++; child < last; child++)
+            if (cmp_timer_action_time(*this->heap[child], *this->heap[min]))
+                min = child;
+        if (!cmp_timer_action_time(*this->heap[min], *item))
+            break;
+        this->heap[i] = this->heap[min];
+        this->heap[i]->heap_index = i;
+        i = min;
+    }
+    this->heap[i] = item;
+    item->heap_index = i;
+}
+timer_id_t timer_mgr::add_timer(uint timer_type,
+    time_t timeouts/*ms*/, timer::Action action, void *arg1, void *arg2)
+{
+    timeval now;
+    if (gettimenow(&now) < 0)
+        return NULL;
+
+    if (this->free_timers == NULL)
+    {
+        timer* page = new timer[TIMER_PAGE_TIMERS];
+        this->pages.push_back(page);
+        for (int i = TIMER_PAGE_TIMERS - 1; i >= 0; i--)
+        {
+            page[i].next_free = this->free_timers;
+            this->free_timers = &page[i];
+        }
+    }
+    timer* item = this->free_timers;
+    this->free_timers = item->next_free;
+
+    item->timer_id = this->tid++;
+    item->timer_type = timer_type;
+    sum_time(&now, timeouts, &item->action_time);
+    item->action = action;
+    item->arg1 = arg1;
+    item->arg2 = arg2;
+
+    if (item->timer_id == 0)
+    {
+        this->tid = 2;
+        item->timer_id = 1;
+    }
+
+    this->heap.push_back(item);
+    this->sift_up((uint) this->heap.size() - 1);
+    return item;
+}
+
+void timer_mgr::delete_timer(timer_id_t& timerptr)
+{
+    if (this->heap.empty() || timerptr == NULL)
+        return;
+    uint i = timerptr->heap_index;
+    timer* last = this->heap.back();
+    this->heap.pop_back();
+    if (last != timerptr)
+    {
+        // the last timer fills the hole and moves whichever way it is out of order
+        this->heap[i] = last;
+        last->heap_index = i;
+        this->sift_up(i);
+        this->sift_down(last->heap_index);
+    }
+    timerptr->timer_id = 0;
+    timerptr->next_free = this->free_timers;
+    this->free_timers = timerptr;
+    timerptr = NULL;
+}
+int timer_mgr::reset_timer(timer_id_t& timerptr, uint timeouts)
+{
+	EVENTLOG(VERBOSE, "reset_timer");
+	if (this->heap.empty() || timerptr == NULL)
+        return -1;
+    timeval now;
+    if (gettimenow(&now) < 0)
+        return -1;
+    sum_time(&now, timeouts, &timerptr->action_time);
+    this->sift_up(timerptr->heap_index);
+    this->sift_down(timerptr->heap_index);
+    return 0;
+}
+int timer_mgr::timeouts()
+{
+	if (this->heap.empty())
+        return -1;
+
+    // get now and timeout
+    struct timeval now;
+    if (gettimenow(&now) < 0) return -1;
+
+    const struct timeval& timeout = this->heap[0]->action_time;
+    int secs = timeout.tv_sec - now.tv_sec;
+    if (secs < 0) return 0; // sec timeouts
+
+	int usecs = timeout.tv_usec - now.tv_usec;
+    if (usecs < 0)
+    {
+        //as usecs has timeout, we need ti check if secs checkouts
+        //if  two secs equals, secs == 0, then must timeout
+        // if two secs difference greater than 1 sec, then must not timeout
+        secs--;
+        usecs += 1000000;
+    }
+
+    if (secs < 0) return 0; //secs timeouts
+
+    // no type overflow because number is very small
+    return ((int)(secs * 1000 + usecs / 1000));
+}
+
+
+void timer_mgr::print_timer(short event_log_level, const timer& item)
+{
+    const char* ttype;
+
+    switch (item.timer_type)
+    {
+        case TIMER_TYPE_INIT:
+            ttype = "Init Timer";
+            break;
+        case TIMER_TYPE_SACK:
+            ttype = "SACK Timer";
+            break;
+        case TIMER_TYPE_RTXM:
+            ttype = "T3 RTX Timer";
+            break;
+        case TIMER_TYPE_SHUTDOWN:
+            ttype = "Shutdown Timer";
+            break;
+        case TIMER_TYPE_CWND:
+            ttype = "CWND Timer";
+            break;
+        case TIMER_TYPE_HEARTBEAT:
+            ttype = "Heartbeat Timer";
+            break;
+        case TIMER_TYPE_USER:
+            ttype = "User Timer";
+            break;
+        default:
+            ttype = "Unknown Timer";
+            break;
+    }
+    EVENTLOG4(VVERBOSE,
+        "TimerID: %u, Type : %s, action_time: {%ld sec, %ld us}",
+        item.timer_id, ttype, item.action_time.tv_sec,
+        item.action_time.tv_usec);
+}
+void timer_mgr::print(short event_log_level)
+{
+    if (this->heap.size() == 0)
+    {
+        EVENTLOG(event_log_level, "No timers!");
+        return;
+    }
+    print_time_now(event_log_level);
+    EVENTLOG1(event_log_level, "Heap Length : %ld", this->heap.size());
+    // heap order, the earliest timer first
+    for (auto timer : this->heap)
+    {
+        this->print_timer(event_log_level, *timer);
+    }
+}
+
+
+
@@ -1,498 +1,624 @@
-/*
- * Copyright (c) 2016
- * Geco Gaming Company
- *
- * Permission to use, copy, modify, distribute and sell this software
- * and its documentation for GECO purpose is hereby granted without fee,
- * provided that the above copyright notice appear in all copies and
- * that both that copyright notice and this permission notice appear
- * in supporting documentation. Geco Gaming makes no
- * representations about the suitability of this software for GECO
- * purpose.  It is provided "as is" without express or implied warranty.
- *
- */
-
-/**
- * Created on 20 May 2016 by Jake Zhang
- * Reviewed on 07 May 2016 by Jakze Zhang
- */
-
-#ifndef __INCLUDE_PROTOCOL_STACK_H
-#define __INCLUDE_PROTOCOL_STACK_H
-#include "geco-net-common.h"
-
-/*
- * Here are some error codes that are returned by some functions
- * this list may be enhanced or become more extensive in future releases
- */
-#define MULP_SUCCESS                         0
-#define MULP_LIBRARY_NOT_INITIALIZED        -1
-#define MULP_INSTANCE_NOT_FOUND             -2
-#define MULP_ASSOC_NOT_FOUND                -3
-#define MULP_PARAMETER_PROBLEM              -4
-#define MULP_MODULE_NOT_FOUND               -5
-#define MULP_OUT_OF_RESOURCES               -6
-#define MULP_NOT_SUPPORTED                  -7
-#define MULP_INSUFFICIENT_PRIVILEGES        -8
-#define MULP_LIBRARY_ALREADY_INITIALIZED    -9
-#define MULP_UNSPECIFIED_ERROR              -10
-#define MULP_QUEUE_EXCEEDED                 -11
-#define MULP_WRONG_ADDRESS                  -12
-#define MULP_WRONG_STATE                    -13
-#define MULP_BUFFER_TOO_SMALL               -14
-#define MULP_NO_CHUNKS_IN_QUEUE             -15
-#define MULP_INSTANCE_IN_USE                -16
-#define MULP_INVALID_STREAM_ID              -17
-#define MULP_NO_USER_DATA                   -18
-#define MULP_PROTOCOL_VIOLATION             -19
-#define MULP_SPECIFIC_FUNCTION_ERROR         -20
-
-enum ChannelState
-{
-  Closed,
-  CookieWait,
-  CookieEchoed,
-  Connected,
-  ShutdownPending,
-  ShutdownReceived,
-  ShutdownSent,
-  ShutdownAckSent,
-  ChannelStateSize,
-  UnknownChannelState,
-};
-
-/// Return codes for a number of functions that treat incoming chunks
-/// these are used in  bundle controller stop processing not sending replying chunk
-enum ChunkProcessResult
-  : int
-  {
-    Good,
-  Stop,
-  SKIP_PROCESS_PARAM_REPORT_ERROR,
-  SKIP_PROCESS_PARAM,
-  StopProcessForUnrecognizedParamError,
-  StopProcessForNewAddrAddedError,
-  StopProcessAndDeleteChannel,
-  StopAndDeleteChannel_LastSrcPortNullError,
-  StopAndDeleteChannel_ValidateInitParamFailedError,
-  ChunkProcessResultSize
-};
-
-/* for COMMUNICATION LOST or COMMUNICATION UP callbacks */
-enum ConnectionLostReason
-  : int
-  {
-    PeerAbortConnection, PeerUnreachable, ExceedMaxRetransCount, NO_TCB, InvalidParam, UnknownParam,
-    // maybe some others.............
-  NumofLostReasons
-};
-
-enum GECONET_ERRNO
-  : int
-  {
-    SUCESS = 0, NULL_MODULE = -1, ILLEGAL_FUNC_PARAM = -2, INACTIVE_PATH = -3,
-};
-
-const uint COMM_UP_RECEIVED_VALID_COOKIE = 1;
-const uint COMM_UP_RECEIVED_COOKIE_ACK = 2;
-const uint COMM_UP_RECEIVED_COOKIE_RESTART = 3;
-const uint MULP_CHECKSUM_ALGORITHM_MD5 = 1;
-const uint MULP_CHECKSUM_ALGORITHM_CRC32C = 2;
-
-/**
- * This struct contains parameters that may be set globally with
- * mulp_setLibraryParams(). For now, it only contains one flag.
- */
-struct lib_params_t
-{
-    /*
-     * flag that controls whether an implementation will send
-     * ABORT chunks for OOTB mulp packets, or whether it will
-     * silently discard these. In the later case, you will be
-     * able to run the implementation twice on one machine, without
-     * the two interfering with each other (also for tests on localhost)
-     * By default, this variable is set to TRUE (==1)
-     * Allowed values are 0 (==FALSE) or 1, else function will fail !!
-     */
-    bool send_ootb_aborts;
-    /*
-     * This allows for globally setting the used checksum algorithm
-     * may be either
-     * - MULP_CHECKSUM_ALGORITHM_MD5 (1,default)
-     * - MULP_CHECKSUM_ALGORITHM_CRC32C (2)
-     */
-    int checksum_algorithm;
-    bool support_particial_reliability; /* does the assoc support unreliable transfer*/
-    bool support_dynamic_addr_config; /* does the assoc support adding/deleting IP addresses*/
-    uint delayed_ack_interval;
-    ushort udp_bind_port; /*the well knwon local binding port for udp-based stack*/
-    uint pmtu_lowest;
-};
-
-/**
- * This struct contains some parameters that may be set or
- * got with the mulp_getAssocDefaults()/mulp_setAssocDefaults()
- * functions. So these may also be specified/retrieved for
- * servers, before an association is established !
- */
-struct geco_instance_params_t
-{
-    /* @{ */
-    /* this is read-only (get) */
-    unsigned int noOfLocalAddresses;
-    /* this is read-only (get) */
-    unsigned char localAddressList[32][MAX_IPADDR_STR_LEN];
-    /* the initial round trip timeout */
-    unsigned int rtoInitial;
-    /* the minimum timeout value */
-    unsigned int rtoMin;
-    /* the maximum timeout value */
-    unsigned int rtoMax;
-    /* the lifetime of a cookie */
-    unsigned int validCookieLife;
-    /*  (get/set) */
-    unsigned short ordered_streams;
-    /*  (get/set) */
-    unsigned short sequenced_streams;
-    /* does the assoc support unreliable transfer*/
-    bool support_particial_reliability;
-    /* does the assoc support adding/deleting IP addresses*/
-    bool support_dynamic_addr_config;
-    /* maximum retransmissions per association */
-    unsigned int assocMaxRetransmits;
-    /* maximum retransmissions per path */
-    unsigned int pathMaxRetransmits;
-    /* maximum initial retransmissions */
-    unsigned int maxInitRetransmits;
-    /* from recvcontrol : my receiver window */
-    unsigned int myRwnd;
-    /* recvcontrol: delay for delayed ACK in msecs */
-    unsigned int delay;
-    /* per instance: for the IP type of service field. */
-    unsigned char ipTos;
-    /* limit the number of chunks queued in the send queue */
-    unsigned int maxSendQueue;
-    /* currently unused, may limit the number of chunks queued in the receive queue later.
-     *  Is this really needed ? The protocol limits the receive queue with
-     *  window advertisement of arwnd==0  */
-    unsigned int maxRecvQueue;
-    /*
-     * maximum number of connections we want. Is this limit greater than 0,
-     * implementation will automatically send ABORTs to incoming INITs, when
-     * there are that many associations !
-     */
-    unsigned int maxNumberOfAssociations;
-    /* @} */
-};
-
-/**
- * this struct contains path specific parameters, so these
- * values can only be retrieved/set, when the association
- * already exists !
- */
-struct path_infos_t
-{
-    /* @{ */
-    /**   */
-    unsigned char destinationAddress[MAX_IPADDR_STR_LEN];
-    /**  mulp_PATH_ACTIVE  0, mulp_PATH_INACTIVE   1    */
-    short state;
-    /** smoothed round trip time in msecs */
-    unsigned int srtt;
-    /** current rto value in msecs */
-    unsigned int rto;
-    /** round trip time variation, in msecs */
-    unsigned int rttvar;
-    /** defines the rate at which heartbeats are sent */
-    unsigned int heartbeatIntervall;
-    /**  congestion window size (flowcontrol) */
-    unsigned int cwnd;
-    /**  congestion window size 2 (flowcontrol) */
-    unsigned int cwnd2;
-    /**  Partial Bytes Acked (flowcontrol) */
-    unsigned int partialBytesAcked;
-    /**  Slow Start Threshold (flowcontrol) */
-    unsigned int ssthresh;
-    /**  from flow control */
-    unsigned int outstandingBytesPerAddress;
-    /**  Current MTU (flowcontrol) */
-    unsigned int mtu;
-    /** per path ? per instance ? for the IP type of service field. */
-    unsigned char ipTos;
-    /* @} */
-};
-
-/**
- *  This struct contains the data to be returned to the ULP with the
- *  mulp_getAssocStatus() function primitive. It is marked whether data
- *  may only be retrieved using the  mulp_getAssocStatus() function, or
- *  also set using the  mulp_setAssocStatus() function.
- */
-struct connection_infos_t
-{
-    /* @{ */
-    /** (get)  */
-    unsigned short state;
-    /**  (get) */
-    unsigned short numberOfAddresses;
-    /**  (get) */
-    unsigned char primaryDestinationAddress[MAX_IPADDR_STR_LEN];
-    /**  (get) */
-    unsigned short sourcePort;
-    /**  (get) */
-    unsigned short destPort;
-    /**  (get) */
-    unsigned short outStreams;
-    /**  (get) */
-    unsigned short inStreams;
-    /** does the assoc support unreliable streams  no==0, yes==1 */
-    unsigned int supportUnreliableStreams;
-    /** does the assoc support adding/deleting IP addresses no==0, yes==1 */
-    unsigned int supportADDIP;
-    /**  (get/set) */
-    unsigned short primaryAddressIndex;
-    /**  (get) */
-    unsigned int currentReceiverWindowSize;
-    /**  (get) */
-    unsigned int outstandingBytes;
-    /**  (get) */
-    unsigned int noOfChunksInSendQueue;
-    /**  (get) */
-    unsigned int noOfChunksInRetransmissionQueue;
-    /**  (get) */
-    unsigned int noOfChunksInReceptionQueue;
-    /** (get/set) the initial round trip timeout */
-    unsigned int rtoInitial;
-    /** (get/set) the minimum RTO timeout */
-    unsigned int rtoMin;
-    /** (get/set) the maximum RTO timeout */
-    unsigned int rtoMax;
-    /** (get/set) the lifetime of a cookie */
-    unsigned int validCookieLife;
-    /** (get/set) maximum retransmissions per association */
-    unsigned int assocMaxRetransmits;
-    /** (get/set) maximum retransmissions per path */
-    unsigned int pathMaxRetransmits;
-    /** (get/set) maximum initial retransmissions */
-    unsigned int maxInitRetransmits;
-    /** (get/set) from recvcontrol : my receiver window */
-    unsigned int myRwnd;
-    /** (get/set) recvcontrol: delay for delayed ACK in msecs */
-    unsigned int delay;
-    /** (get/set) per instance: for the IP type of service field. */
-    unsigned char ipTos;
-    /**  limit the number of chunks queued in the send queue */
-    unsigned int maxSendQueue;
-    /** currently unused, may limit the number of chunks queued in the receive queue later.
-     *  Is this really needed ? The protocol limits the receive queue with
-     *  window advertisement of arwnd==0  */
-    unsigned int maxRecvQueue;
-    /* @} */
-};
-
-/**
- This struct containes the pointers to ULP callback functions.
- Each mulp-instance can have its own set of callback functions.
- The callback functions of each mulp-instance can be found by
- first reading the datastruct of an association from the list of
- associations. The datastruct of the association contains the name
- of the mulp instance to which it belongs. With the name of the mulp-
- instance its datastruct can be read from the list of mulp-instances.
- */
-struct ulp_cbs_t
-{
-    /* @{ */
-    /**
-     * indicates that new data arrived from peer (chapter 10.2.A).
-     *  @param 1 connectionid
-     *  @param 2 streamID
-     *  @param 3 length of data
-     *  @param 4 stream sequence number
-     *  @param 5 tsn of (at least one) chunk belonging to the message
-     *  @param 6 unreliable flag (TRUE==1==unreliable, FALSE==0==reliable)
-     *  @param 7 unordered flag (TRUE==1==unordered, FALSE==0==normal, numbered chunk)
-     *  @param 8 pointer to ULP data
-     */
-    void (*dataArriveNotif)(unsigned int, unsigned short, unsigned int, unsigned short, unsigned int, unsigned int,
-        unsigned int, void*);
-    /**
-     * indicates a send failure (chapter 10.2.B).
-     *  @param 1 connectionid
-     *  @param 2 pointer to data not sent
-     *  @param 3 dataLength
-     *  @param 4 pointer to context from sendChunk
-     *  @param 5 pointer to ULP data
-     */
-    void (*sendFailureNotif)(unsigned int, unsigned char *, unsigned int, unsigned int *, void*);
-    /**
-     * indicates a change of network status (chapter 10.2.C).
-     *  @param 1 connectionid
-     *  @param 2 destinationAddresses
-     *  @param 3 newState
-     *  @param 4 pointer to ULP data
-     */
-    void (*networkStatusChangeNotif)(unsigned int, short, unsigned short, void*);
-    /**
-     * indicates that a association is established (chapter 10.2.D).
-     *  @param 1 connectionid
-     *  @param 2 status, type of event
-     *  @param 3 number of destination addresses
-     *  @param 4 number input streamns
-     *  @param 5 number output streams
-     *  @param 6 int  do I supportPR (0=FALSE, 1=TRUE)
-     *  @param 7 int  do peer supportPR (0=FALSE, 1=TRUE)
-     *  @param 8 int  do I support addip (0=FALSE, 1=TRUE)
-     *  @param 9 int  do peer support addip (0=FALSE, 1=TRUE)
-     *  @param 10 pointer to ULP data, usually NULL
-     *  @return the callback is to return a pointer, that will be transparently returned with every callback
-     */
-    void* (*communicationUpNotif)(unsigned int, int, unsigned int, unsigned short, unsigned short, int, int, int, int,
-        void*);
-    /**
-     * indicates that communication was lost to peer (chapter 10.2.E).
-     *  @param 1 connectionid
-     *  @param 2 status, type of event
-     *  @param 3 pointer to ULP data
-     */
-    void (*communicationLostNotif)(unsigned int, unsigned short, void*);
-    /**
-     * indicates that communication had an error. (chapter 10.2.F)
-     * Currently not implemented !?
-     *  @param 1 connectionid
-     *  @param 2 status, type of error
-     *  @param 3 pointer to ULP data
-     */
-    void (*communicationErrorNotif)(unsigned int, unsigned short, void*);
-    /**
-     * indicates that a RESTART has occurred. (chapter 10.2.G)
-     *  @param 1 connectionid
-     *  @param 2 pointer to ULP data
-     */
-    void (*restartNotif)(unsigned int, void*);
-    /**
-     * indicates that a SHUTDOWN has been received by the peer. Tells the
-     * application to stop sending new data.
-     *  @param 0 instanceID
-     *  @param 1 connectionid
-     *  @param 2 pointer to ULP data
-     */
-    void (*peerShutdownReceivedNotif)(unsigned int, void*);
-    /**
-     * indicates that a SHUTDOWN has been COMPLETED. (chapter 10.2.H)
-     *  @param 0 instanceID
-     *  @param 1 connectionid
-     *  @param 2 pointer to ULP data
-     */
-    void (*shutdownCompleteNotif)(unsigned int, void*);
-    /**
-     * indicates that a queue length has exceeded (or length has dropped
-     * below) a previously determined limit
-     *  @param 0 connectionid
-     *  @param 1 queue type (in-queue, out-queue, stream queue etc.)
-     *  @param 2 queue identifier (maybe for streams ? 0 if not used)
-     *  @param 3 queue length (either bytes or messages - depending on type)
-     *  @param 4 pointer to ULP data
-     */
-    void (*queueStatusChangeNotif)(unsigned int, int, int, int, void*);
-    /**
-     * indicates that a ASCONF request from the ULP has succeeded or failed.
-     *  @param 0 connectionid
-     *  @param 1 correlation ID
-     *  @param 2 result (int, negative for error)
-     *  @param 3 pointer to a temporary, request specific structure (NULL if not needed)
-     *  @param 4 pointer to ULP data
-     */
-    void (*asconfStatusNotif)(unsigned int, unsigned int, int, void*, void*);
-    /* @} */
-};
-
-/**
- * Function that needs to be called in advance to all library calls.
- * It initializes all file descriptors etc. and sets up some variables
- * @return 0 for success, 1 for adaptation level error, -1 if already called
- * (i.e. the function has already been called before), -2 for insufficient rights
- * (you need root-rights to open RAW sockets !).
- */
-int initialize_library(void);
-void free_library(void);
-
-/**
- *  sctp_registerInstance is called to initialize one SCTP-instance.
- *  Each Adaption-Layer of the ULP must create its own SCTP-instance, and
- *  define and register appropriate callback functions.
- *  An SCTP-instance may define an own port, or zero here ! Servers and clients
- *  that care for their source port must chose a port, clients that do not really
- *  care which source port they use, chose ZERO, and have the implementation chose
- *  a free source port.
- *
- *  @param port                   wellknown port of this sctp-instance
- *  @param noOfLocalAddresses     number of local addresses
- *  @param localAddressList       local address list (pointer to a string-array)
- *  @param ULPcallbackFunctions   call back functions for primitives passed from sctp to ULP
- *  @return     instance id  otherwise  fatal error exit
- */
-int mulp_new_geco_instance(unsigned short localPort, unsigned short noOfInStreams, unsigned short noOfOutStreams,
-    unsigned int noOfLocalAddresses, unsigned char localAddressList[MAX_NUM_ADDRESSES][MAX_IPADDR_STR_LEN],
-    ulp_cbs_t ULPcallbackFunctions);
-
-/// success returns MULP_SUCCESS
-/// error returns MULP_INSTANCE_NOT_FOUND MULP_INSTANCE_IN_USE
-int mulp_delete_geco_instance(int instance_name);
-
-/// This function is called to setup an association.
-/// The ULP must specify the instance id to which this association belongs to.
-/// @param instanceid     the instance this association belongs to.
-/// if the local port of this SCTP instance is zero, we will get a port num,
-/// else we will use the one from the SCTP instance !
-/// @param noOfOutStreams        number of output streams the ULP would like to have
-/// @param destinationAddress    destination address
-/// @param destinationPort       destination port
-/// @param ulp_data             pointer to an ULP data structure, will be passed with callbacks !
-/// @return connection ID, 0 in case of failures
-int mulp_connect(unsigned int instanceid, unsigned short noOfOrderStreams, unsigned short noOfSeqStreams,
-    char destinationAddress[MAX_IPADDR_STR_LEN], unsigned short destinationPort, void* ulp_data);
-int mulp_connectx(unsigned int instanceid, unsigned short noOfOrderStreams, unsigned short noOfSeqStreams,
-    char destinationAddresses[MAX_NUM_ADDRESSES][MAX_IPADDR_STR_LEN], unsigned int noOfDestinationAddresses,
-    unsigned int maxSimultaneousInits, unsigned short destinationPort, void* ulp_data);
-
-/// mulp_shutdown initiates the shutdown of the specified connection.
-/// @param    connectionid  the ID of the connection.
-/// @return   0 for success, 1 for error (connection does not exist)
-int mulp_shutdown(unsigned int connectionid);
-/// mulp_abort initiates the abort of the specified connection.
-/// @param    connectionid  the ID of the connection.
-/// @return   0 for success, 1 for error (connection does not exist)
-int mulp_abort(unsigned int connectionid);
-
-/*----------------------------------------------------------------------------------------------*/
-/*  These are the new function for getting/setting parameters per instance, association or path */
-/*----------------------------------------------------------------------------------------------*/
-int mulp_set_lib_params(lib_params_t *lib_params);
-int mulp_get_lib_params(lib_params_t *lib_params);
-int mulp_set_connection_default_params(unsigned int instanceid, geco_instance_params_t* geco_instance_params);
-int mulp_get_connection_default_params(unsigned int instanceid, geco_instance_params_t* geco_instance_params);
-int mulp_get_connection_params(unsigned int connectionid, connection_infos_t* status);
-int mulp_set_connection_params(unsigned int connectionid, connection_infos_t* new_status);
-int mulp_get_path_params(unsigned int connectionid, short path_id, path_infos_t* status);
-int mulp_set_path_params(unsigned int connectionid, short path_id, path_infos_t *new_status);
-
-/*----------------------------------------------------------------------------------------------*/
-/*                            set cb for transport module                                       */
-/*----------------------------------------------------------------------------------------------*/
-#include <functional>
-typedef std::function<int(void* user_data)> socket_read_start_cb_t;
-typedef std::function<
-    int(int sfd, bool isudpsocket, char* data, int datalen, sockaddrunion* from, sockaddrunion* to, void* user_data)> socket_read_end_cb_t;
-typedef std::function<int(void* user_data)> select_cb_t;
-
-extern void mulp_set_socket_read_handler(socket_read_start_cb_t& mtra_socket_read_start,
-    socket_read_end_cb_t& mtra_socket_read_end, void* start_arg = 0, void* end_args = 0);
-extern void mulp_enable_socket_read_handler();
-extern void mulp_disable_socket_read_handler();
-
-extern void mulp_set_mtra_select_handler(select_cb_t& mtra_select_start, select_cb_t& mtra_select_end, void* start_arg =
-    0, void* end_args = 0);
-extern void mulp_enable_mtra_select_handler();
-extern void mulp_disable_mtra_select_handler();
-
-#endif
+/*
+ * Copyright (c) 2016
+ * Geco Gaming Company
+ *
+ * Permission to use, copy, modify, distribute and sell this software
+ * and its documentation for GECO purpose is hereby granted without fee,
+ * provided that the above copyright notice appear in all copies and
+ * that both that copyright notice and this permission notice appear
+ * in supporting documentation. Geco Gaming makes no
+ * representations about the suitability of this software for GECO
+ * purpose.  It is provided "as is" without express or implied warranty.
+ *
+ */
+
+/**
+ * Created on 20 May 2016 by Jake Zhang
+ * Reviewed on 07 May 2016 by Jakze Zhang
+ */
+
+#ifndef __INCLUDE_PROTOCOL_STACK_H
+#define __INCLUDE_PROTOCOL_STACK_H
+#include "geco-net-common.h"
+
+/*
+ * Here are some error codes that are returned by some functions
+ * this list may be enhanced or become more extensive in future releases
+ */
+#define MULP_SUCCESS                         0
+#define MULP_LIBRARY_NOT_INITIALIZED        -1
+#define MULP_INSTANCE_NOT_FOUND             -2
+#define MULP_ASSOC_NOT_FOUND                -3
+#define MULP_PARAMETER_PROBLEM              -4
+#define MULP_MODULE_NOT_FOUND               -5
+#define MULP_OUT_OF_RESOURCES               -6
+#define MULP_NOT_SUPPORTED                  -7
+#define MULP_INSUFFICIENT_PRIVILEGES        -8
+#define MULP_LIBRARY_ALREADY_INITIALIZED    -9
+#define MULP_UNSPECIFIED_ERROR              -10
+#define MULP_QUEUE_EXCEEDED                 -11
+#define MULP_WRONG_ADDRESS                  -12
+#define MULP_WRONG_STATE                    -13
+#define MULP_BUFFER_TOO_SMALL               -14
+#define MULP_NO_CHUNKS_IN_QUEUE             -15
+#define MULP_INSTANCE_IN_USE                -16
+#define MULP_INVALID_STREAM_ID              -17
+#define MULP_NO_USER_DATA                   -18
+#define MULP_PROTOCOL_VIOLATION             -19
+#define MULP_SPECIFIC_FUNCTION_ERROR         -20
+
+enum ChannelState
+{
+  Closed,
+  CookieWait,
+  CookieEchoed,
+  Connected,
+  ShutdownPending,
+  ShutdownReceived,
+  ShutdownSent,
+  ShutdownAckSent,
+  ChannelStateSize,
+  UnknownChannelState,
+};
+
+/// Return codes for a number of functions that treat incoming chunks
+/// these are used in  bundle controller stop processing not sending replying chunk
+enum ChunkProcessResult
+  : int
+  {
+    Good,
+  Stop,
+  SKIP_PROCESS_PARAM_REPORT_ERROR,
+  SKIP_PROCESS_PARAM,
+  StopProcessForUnrecognizedParamError,
+  StopProcessForNewAddrAddedError,
+  StopProcessAndDeleteChannel,
+  StopAndDeleteChannel_LastSrcPortNullError,
+  StopAndDeleteChannel_ValidateInitParamFailedError,
+  ChunkProcessResultSize
+};
+
+/* for COMMUNICATION LOST or COMMUNICATION UP callbacks */
+enum ConnectionLostReason
+  : int
+  {
+    PeerAbortConnection, PeerUnreachable, ExceedMaxRetransCount, NO_TCB, InvalidParam, UnknownParam,
+    // maybe some others.............
+  NumofLostReasons
+};
+
+enum GECONET_ERRNO
+  : int
+  {
+    SUCESS = 0, NULL_MODULE = -1, ILLEGAL_FUNC_PARAM = -2, INACTIVE_PATH = -3,
+};
+
+const uint COMM_UP_RECEIVED_VALID_COOKIE = 1;
+const uint COMM_UP_RECEIVED_COOKIE_ACK = 2;
+const uint COMM_UP_RECEIVED_COOKIE_RESTART = 3;
+const uint MULP_CHECKSUM_ALGORITHM_MD5 = 1;
+const uint MULP_CHECKSUM_ALGORITHM_CRC32C = 2;
+
+/**
+ * This struct contains parameters that may be set globally with
+ * mulp_setLibraryParams(). For now, it only contains one flag.
+ */
+struct lib_params_t
+{
+    /*
+     * flag that controls whether an implementation will send
+     * ABORT chunks for OOTB mulp packets, or whether it will
+     * silently discard these. In the later case, you will be
+     * able to run the implementation twice on one machine, without
+     * the two interfering with each other (also for tests on localhost)
+     * By default, this variable is set to TRUE (==1)
+     * Allowed values are 0 (==FALSE) or 1, else function will fail !!
+     */
+    bool send_ootb_aborts;
+    /*
+     * This allows for globally setting the used checksum algorithm
+     * may be either
+     * - MULP_CHECKSUM_ALGORITHM_MD5 (1,default)
+     * - MULP_CHECKSUM_ALGORITHM_CRC32C (2)
+     */
+    int checksum_algorithm;
+    bool support_particial_reliability; /* does the assoc support unreliable transfer*/
+    bool support_dynamic_addr_config; /* does the assoc support adding/deleting IP addresses*/
+    uint delayed_ack_interval;
+    ushort udp_bind_port; /*the well knwon local binding port for udp-based stack*/
+    uint pmtu_lowest;
+};
+
+/**
+ * This struct contains some parameters that may be set or
+ * got with the mulp_getAssocDefaults()/mulp_setAssocDefaults()
+ * functions. So these may also be specified/retrieved for
+ * servers, before an association is established !
+ */
+struct geco_instance_params_t
+{
+    /* @{ */
+    /* this is read-only (get) */
+    unsigned int noOfLocalAddresses;
+    /* this is read-only (get) */
+    unsigned char localAddressList[32][MAX_IPADDR_STR_LEN];
+    /* the initial round trip timeout */
+    unsigned int rtoInitial;
+    /* the minimum timeout value */
+    unsigned int rtoMin;
+    /* the maximum timeout value */
+    unsigned int rtoMax;
+    /* the lifetime of a cookie */
+    unsigned int validCookieLife;
+    /*  (get/set) */
+    unsigned short ordered_streams;
+    /*  (get/set) */
+    unsigned short sequenced_streams;
+    /* does the assoc support unreliable transfer*/
+    bool support_particial_reliability;
+    /* does the assoc support adding/deleting IP addresses*/
+    bool support_dynamic_addr_config;
+    /* maximum retransmissions per association */
+    unsigned int assocMaxRetransmits;
+    /* maximum retransmissions per path */
+    unsigned int pathMaxRetransmits;
+    /* maximum initial retransmissions */
+    unsigned int maxInitRetransmits;
+    /* from recvcontrol : my receiver window */
+    unsigned int myRwnd;
+    /* recvcontrol: delay for delayed ACK in msecs */
+    unsigned int delay;
+    /* per instance: for the IP type of service field. */
+    unsigned char ipTos;
+    /* limit the number of chunks queued in the send queue */
+    unsigned int maxSendQueue;
+    /* currently unused, may limit the number of chunks queued in the receive queue later.
+     *  Is this really needed ? The protocol limits the receive queue with
+     *  window advertisement of arwnd==0  */
+    unsigned int maxRecvQueue;
+    /*
+     * maximum number of connections we want. Is this limit greater than 0,
+     * implementation will automatically send ABORTs to incoming INITs, when
+     * there are that many associations !
+     */
+    unsigned int maxNumberOfAssociations;
+    /* @} */
+};
+
+/**
+ * this struct contains path specific parameters, so these
+ * values can only be retrieved/set, when the association
+ * already exists !
+ */
+struct path_infos_t
+{
+    /* @{ */
+    /**   */
+    unsigned char destinationAddress[MAX_IPADDR_STR_LEN];
+    /**  mulp_PATH_ACTIVE  0, mulp_PATH_INACTIVE   1    */
+    short state;
+    /** smoothed round trip time in msecs */
+    unsigned int srtt;
+    /** current rto value in msecs */
+    unsigned int rto;
+    /** round trip time variation, in msecs */
+    unsigned int rttvar;
+    /** defines the rate at which heartbeats are sent */
+    unsigned int heartbeatIntervall;
+    /**  congestion window size (flowcontrol) */
+    unsigned int cwnd;
+    /**  congestion window size 2 (flowcontrol) */
+    unsigned int cwnd2;
+    /**  Partial Bytes Acked (flowcontrol) */
+    unsigned int partialBytesAcked;
+    /**  Slow Start Threshold (flowcontrol) */
+    unsigned int ssthresh;
+    /**  from flow control */
+    unsigned int outstandingBytesPerAddress;
+    /**  Current MTU (flowcontrol) */
+    unsigned int mtu;
+    /** per path ? per instance ? for the IP type of service field. */
+    unsigned char ipTos;
+    /* @} */
+};
+
+/**
+ *  This struct contains the data to be returned to the ULP with the
+ *  mulp_getAssocStatus() function primitive. It is marked whether data
+ *  may only be retrieved using the  mulp_getAssocStatus() function, or
+ *  also set using the  mulp_setAssocStatus() function.
+ */
+struct connection_infos_t
+{
+    /* @{ */
+    /** (get)  */
+    unsigned short state;
+    /**  (get) */
+    unsigned short numberOfAddresses;
+    /**  (get) */
+    unsigned char primaryDestinationAddress[MAX_IPADDR_STR_LEN];
+    /**  (get) */
+    unsigned short sourcePort;
+    /**  (get) */
+    unsigned short destPort;
+    /**  (get) */
+    unsigned short outStreams;
+    /**  (get) */
+    unsigned short inStreams;
+    /** does the assoc support unreliable streams  no==0, yes==1 */
+    unsigned int supportUnreliableStreams;
+    /** does the assoc support adding/deleting IP addresses no==0, yes==1 */
+    unsigned int supportADDIP;
+    /**  (get/set) */
+    unsigned short primaryAddressIndex;
+    /**  (get) */
+    unsigned int currentReceiverWindowSize;
+    /**  (get) */
+    unsigned int outstandingBytes;
+    /**  (get) */
+    unsigned int noOfChunksInSendQueue;
+    /**  (get) */
+    unsigned int noOfChunksInRetransmissionQueue;
+    /**  (get) */
+    unsigned int noOfChunksInReceptionQueue;
+    /** (get/set) the initial round trip timeout */
+    unsigned int rtoInitial;
+    /** (get/set) the minimum RTO timeout */
+    unsigned int rtoMin;
+    /** (get/set) the maximum RTO timeout */
+    unsigned int rtoMax;
+    /** (get/set) the lifetime of a cookie */
+    unsigned int validCookieLife;
+    /** (get/set) maximum retransmissions per association */
+    unsigned int assocMaxRetransmits;
+    /** (get/set) maximum retransmissions per path */
+    unsigned int pathMaxRetransmits;
+    /** (get/set) maximum initial retransmissions */
+    unsigned int maxInitRetransmits;
+    /** (get/set) from recvcontrol : my receiver window */
+    unsigned int myRwnd;
+    /** (get/set) recvcontrol: delay for delayed ACK in msecs */
+    unsigned int delay;
+    /** (get/set) per instance: for the IP type of service field. */
+    unsigned char ipTos;
+    /**  limit the number of chunks queued in the send queue */
+    unsigned int maxSendQueue;
+    /** currently unused, may limit the number of chunks queued in the receive queue later.
+     *  Is this really needed ? The protocol limits the receive queue with
+     *  window advertisement of arwnd==0  */
+    unsigned int maxRecvQueue;
+    /* @} */
+};
+
+/**
+ This struct containes the pointers to ULP callback functions.
+ Each mulp-instance can have its own set of callback functions.
+ The callback functions of each mulp-instance can be found by
+ first reading the datastruct of an association from the list of
+ associations. The datastruct of the association contains the name
+ of the mulp instance to which it belongs. With the name of the mulp-
+ instance its datastruct can be read from the list of mulp-instances.
+ */
+struct ulp_cbs_t
+{
+    /* @{ */
+    /**
+     * indicates that new data arrived from peer (chapter 10.2.A).
+     *  @param 1 connectionid
+     *  @param 2 streamID
+     *  @param 3 length of data
+     *  @param 4 stream sequence number
+     *  @param 5 tsn of (at least one) chunk belonging to the message
+     *  @param 6 unreliable flag (TRUE==1==unreliable, FALSE==0==reliable)
+     *  @param 7 unordered flag (TRUE==1==unordered, FALSE==0==normal, numbered chunk)
+     *  @param 8 pointer to ULP data
+     */
+    void (*dataArriveNotif)(unsigned int, unsigned short, unsigned int, unsigned short, unsigned int, unsigned int,
+        unsigned int, void*);
+    /**
+     * indicates a send failure (chapter 10.2.B).
+     *  @param 1 connectionid
+     *  @param 2 pointer to data not sent
+     *  @param 3 dataLength
+     *  @param 4 pointer to context from sendChunk
+     *  @param 5 pointer to ULP data
+     */
+    void (*sendFailureNotif)(unsigned int, unsigned char *, unsigned int, unsigned int *, void*);
+    /**
+     * indicates a change of network status (chapter 10.2.C).
+     *  @param 1 connectionid
+     *  @param 2 destinationAddresses
+     *  @param 3 newState
+     *  @param 4 pointer to ULP data
+     */
+    void (*networkStatusChangeNotif)(unsigned int, short, unsigned short, void*);
+    /**
+     * indicates that a association is established (chapter 10.2.D).
+     *  @param 1 connectionid
+     *  @param 2 status, type of event
+     *  @param 3 number of destination addresses
+     *  @param 4 number input streamns
+     *  @param 5 number output streams
+     *  @param 6 int  do I supportPR (0=FALSE, 1=TRUE)
+     *  @param 7 int  do peer supportPR (0=FALSE, 1=TRUE)
+     *  @param 8 int  do I support addip (0=FALSE, 1=TRUE)
+     *  @param 9 int  do peer support addip (0=FALSE, 1=TRUE)
+     *  @param 10 pointer to ULP data, usually NULL
+     *  @return the callback is to return a pointer, that will be transparently returned with every callback
+     */
+    void* (*communicationUpNotif)(unsigned int, int, unsigned int, unsigned short, unsigned short, int, int, int, int,
+        void*);
+    /**
+     * indicates that communication was lost to peer (chapter 10.2.E).
+     *  @param 1 connectionid
+     *  @param 2 status, type of event
+     *  @param 3 pointer to ULP data
+     */
+    void (*communicationLostNotif)(unsigned int, unsigned short, void*);
+    /**
+     * indicates that communication had an error. (chapter 10.2.F)
+     * Currently not implemented !?
+     *  @param 1 connectionid
+     *  @param 2 status, type of error
+     *  @param 3 pointer to ULP data
+     */
+    void (*communicationErrorNotif)(unsigned int, unsigned short, void*);
+    /**
+     * indicates that a RESTART has occurred. (chapter 10.2.G)
+     *  @param 1 connectionid
+     *  @param 2 pointer to ULP data
+     */
+    void (*restartNotif)(unsigned int, void*);
+    /**
+     * indicates that a SHUTDOWN has been received by the peer. Tells the
+     * application to stop sending new data.
+     *  @param 0 instanceID
+     *  @param 1 connectionid
+     *  @param 2 pointer to ULP data
+     */
+    void (*peerShutdownReceivedNotif)(unsigned int, void*);
+    /**
+     * indicates that a SHUTDOWN has been COMPLETED. (chapter 10.2.H)
+     *  @param 0 instanceID
+     *  @param 1 connectionid
+     *  @param 2 pointer to ULP data
+     */
+    void (*shutdownCompleteNotif)(unsigned int, void*);
+    /**
+     * indicates that a queue length has exceeded (or length has dropped
+     * below) a previously determined limit
+     *  @param 0 connectionid
+     *  @param 1 queue type (in-queue, out-queue, stream queue etc.)
+     *  @param 2 queue identifier (maybe for streams ? 0 if not used)
+     *  @param 3 queue length (either bytes or messages - depending on type)
+     *  @param 4 pointer to ULP data
+     */
+    void (*queueStatusChangeNotif)(unsigned int, int, int, int, void*);
+    /**
+     * indicates that a ASCONF request from the ULP has succeeded or failed.
+     *  @param 0 connectionid
+     *  @param 1 correlation ID
+     *  @param 2 result (int, negative for error)
+     *  @param 3 pointer to a temporary, request specific structure (NULL if not needed)
+     *  @param 4 pointer to ULP data
+     */
+    void (*asconfStatusNotif)(unsigned int, unsigned int, int, void*, void*);
+    /* @} */
+};
+
+/**
+ * Function that needs to be called in advance to all library calls.
+ * It initializes all file descriptors etc. and sets up some variables
+ * @return 0 for success, 1 for adaptation level error, -1 if already called
+ * (i.e. the function has already been called before), -2 for insufficient rights
+ * (you need root-rights to open RAW sockets !).
+ */
+int initialize_library(void);
+void free_library(void);
+
+/**
+ *  sctp_registerInstance is called to initialize one SCTP-instance.
+ *  Each Adaption-Layer of the ULP must create its own SCTP-instance, and
+ *  define and register appropriate callback functions.
+ *  An SCTP-instance may define an own port, or zero here ! Servers and clients
+ *  that care for their source port must chose a port, clients that do not really
+ *  care which source port they use, chose ZERO, and have the implementation chose
+ *  a free source port.
+ *
+ *  @param port                   wellknown port of this sctp-instance
+ *  @param noOfLocalAddresses     number of local addresses
+ *  @param localAddressList       local address list (pointer to a string-array)
+ *  @param ULPcallbackFunctions   call back functions for primitives passed from sctp to ULP
+ *  @return     instance id  otherwise  fatal error exit
+ */
+int mulp_new_geco_instance(unsigned short localPort, unsigned short noOfInStreams, unsigned short noOfOutStreams,
+    unsigned int noOfLocalAddresses, unsigned char localAddressList[MAX_NUM_ADDRESSES][MAX_IPADDR_STR_LEN],
+    ulp_cbs_t ULPcallbackFunctions);
+
+/// success returns MULP_SUCCESS
+/// error returns MULP_INSTANCE_NOT_FOUND MULP_INSTANCE_IN_USE
+int mulp_delete_geco_instance(int instance_name);
+
+/// This function is called to setup an association.
+/// The ULP must specify the instance id to which this association belongs to.
+/// @param instanceid     the instance this association belongs to.
+/// if the local port of this SCTP instance is zero, we will get a port num,
+/// else we will use the one from the SCTP instance !
+/// @param noOfOutStreams        number of output streams the ULP would like to have
+/// @param destinationAddress    destination address
+/// @param destinationPort       destination port
+/// @param ulp_data             pointer to an ULP data structure, will be passed with callbacks !
+/// @return connection ID, 0 in case of failures
+int mulp_connect(unsigned int instanceid, unsigned short noOfOrderStreams, unsigned short noOfSeqStreams,
+    char destinationAddress[MAX_IPADDR_STR_LEN], unsigned short destinationPort, void* ulp_data);
+int mulp_connectx(unsigned int instanceid, unsigned short noOfOrderStreams, unsigned short noOfSeqStreams,
+    char destinationAddresses[MAX_NUM_ADDRESSES][MAX_IPADDR_STR_LEN], unsigned int noOfDestinationAddresses,
+    unsigned int maxSimultaneousInits, unsigned short destinationPort, void* ulp_data);
+/// Same as mulp_connect() but reconnects with the resumption ticket the server gave us with its last
+/// COOKIE ACK, skipping INIT / INIT ACK. The ticket is used once. Without a valid ticket for this
+/// destination, or when the server does not take it, a full handshake is run instead.
+/// @return connection ID, 0 in case of failures
+int mulp_connect_resume(unsigned int instanceid, unsigned short noOfOrderStreams, unsigned short noOfSeqStreams,
+    char destinationAddress[MAX_IPADDR_STR_LEN], unsigned short destinationPort, void* ulp_data);
+
+/// mulp_shutdown initiates the shutdown of the specified connection.
+/// @param    connectionid  the ID of the connection.
+/// @return   0 for success, 1 for error (connection does not exist)
+int mulp_shutdown(unsigned int connectionid);
+/// mulp_abort initiates the abort of the specified connection.
+/// @param    connectionid  the ID of the connection.
+/// @return   0 for success, 1 for error (connection does not exist)
+int mulp_abort(unsigned int connectionid);
+
+/*----------------------------------------------------------------------------------------------*/
+/*                                     sending messages                                         */
+/*----------------------------------------------------------------------------------------------*/
+/* how a message is sent, no flag sends it unreliable and unordered. messages are sent
+ * unreliable only, there is no retransmission nor congestion control for reliable ones yet */
+#define MULP_SEND_SEQUENCED 0x01 /// older messages of its sequenced stream are dropped
+
+/// one piece of a message, the pieces of a message are sent as one
+struct mulp_iov_t
+{
+    const void* data;
+    uint len;
+};
+/// a message of mulp_send_batch()
+struct mulp_send_t
+{
+    uint connectionid;
+    ushort streamID; /// sequenced stream, ignored for unsequenced messages
+    uint flags; /// MULP_SEND_*
+    const mulp_iov_t* iov;
+    uint iovcnt;
+    int result; /// set by mulp_send_batch(), the return value mulp_sendv() would have given
+};
+
+/// Network thread. Sends a message of @iovcnt pieces on a connection. The message must fit
+/// into one packet, it is compressed first when compression is on.
+/// @return MULP_SUCCESS, MULP_ASSOC_NOT_FOUND, MULP_WRONG_STATE when the connection is not
+/// established, MULP_INVALID_STREAM_ID, MULP_NO_USER_DATA, MULP_BUFFER_TOO_SMALL when the
+/// message does not fit into a packet, MULP_PARAMETER_PROBLEM for flags other than MULP_SEND_*
+int mulp_sendv(unsigned int connectionid, unsigned short streamID, unsigned int flags, const mulp_iov_t* iov,
+    unsigned int iovcnt);
+/// Network thread. Same as mulp_sendv() with one piece.
+int mulp_send(unsigned int connectionid, unsigned short streamID, unsigned int flags, const void* data,
+    unsigned int len);
+/// Network thread. Sends @count messages, on any connections, as if each went through
+/// mulp_sendv(), but fills the packets of a connection with as many of them as fit and
+/// sends each connection's last packet once all messages are queued.
+/// @return number of messages sent, the result of each is in its result
+int mulp_send_batch(mulp_send_t* msgs, unsigned int count);
+/// Network thread. Turns lz compression of the messages sent on a connection on or off, off
+/// by default. Compressed messages are sent only when they save enough, the peer always
+/// decompresses them whatever its own setting.
+/// @return MULP_SUCCESS or MULP_ASSOC_NOT_FOUND
+int mulp_set_compression(unsigned int connectionid, bool enable);
+
+/*----------------------------------------------------------------------------------------------*/
+/*             operations submitted by other threads to the thread running mtra_poll()          */
+/*----------------------------------------------------------------------------------------------*/
+#define MULP_OP_CONNECT     1
+#define MULP_OP_SHUTDOWN    2
+#define MULP_OP_ABORT       3
+#define MULP_OP_CALL        4
+#define MULP_OP_SEND        5
+
+/// an operation any thread can hand to the network thread with mulp_submit(),
+/// which runs it at the start of its next mtra_poll(). with a stack per thread, the
+/// network thread is the one that called initialize_library() first
+struct mulp_op_t
+{
+    uint op; /// MULP_OP_*
+    uint token; /// echoed in the completion, 0 for no completion
+    uint id; /// instance id for MULP_OP_CONNECT, connection id for the other ops
+    /* MULP_OP_CONNECT, same as the params of mulp_connect() */
+    ushort noOfOrderStreams;
+    ushort noOfSeqStreams;
+    ushort destinationPort;
+    char destinationAddress[MAX_IPADDR_STR_LEN];
+    void* ulp_data;
+    /* MULP_OP_CALL, any function to run on the network thread */
+    int (*call)(void* arg);
+    void* arg;
+    /* MULP_OP_SEND, same as the params of mulp_send(). the network thread reads @data when
+     * it runs the op, the buffer must stay untouched until then, submit with a token to know */
+    ushort streamID;
+    uint send_flags;
+    const void* data;
+    uint len;
+};
+/// result of an operation submitted with a token, result is what the mulp_* call
+/// of the operation returned, or the function of MULP_OP_CALL
+struct mulp_completion_t
+{
+    uint op;
+    uint token;
+    int result;
+};
+
+/// Any thread, never blocks. Wakes the network thread up if it sleeps in mtra_poll().
+/// @return MULP_SUCCESS, MULP_QUEUE_EXCEEDED when the submission queue is full
+int mulp_submit(const mulp_op_t* op);
+/// Any thread, submits @count ops with one wakeup.
+/// @return number of ops submitted, stops at the first one that does not fit
+int mulp_submit_bulk(const mulp_op_t* ops, uint count);
+/// Takes up to @max completions. One thread at a time may call it, typically
+/// the game thread handing them on to the workers that submitted the ops.
+/// @return number of completions taken
+int mulp_poll_completions(mulp_completion_t* completions, uint max);
+
+/// a message that arrived during a poll, the params of dataArriveNotif plus the message
+struct mulp_data_arrive_t
+{
+    uint connectionid;
+    ushort streamID;
+    ushort streamSN;
+    uint length;
+    uint tsn;
+    uchar unreliable; /// TRUE==1==unreliable, FALSE==0==reliable
+    uchar unordered; /// TRUE==1==unordered, FALSE==0==normal, numbered chunk
+    const uchar* data; /// @length bytes of the message
+    void* ulp_data; /// ulp data of the connection
+};
+typedef void (*data_arrive_batch_cb_t)(const mulp_data_arrive_t* arrivals, uint count, void* user_data);
+/// Network thread. Opt-in batched delivery: with a callback set, the messages arriving
+/// during mtra_poll() are not notified one by one with dataArriveNotif but collected
+/// and handed to @cb at once at the end of the poll, in the order they were delivered,
+/// so the messages of one connection and stream keep their order. The data pointers
+/// stay valid until @cb returns, the messages are freed then.
+/// @cb NULL goes back to dataArriveNotif
+void mulp_set_data_arrive_batch_cb(data_arrive_batch_cb_t cb, void* user_data);
+
+/*----------------------------------------------------------------------------------------------*/
+/*  These are the new function for getting/setting parameters per instance, association or path */
+/*----------------------------------------------------------------------------------------------*/
+int mulp_set_lib_params(lib_params_t *lib_params);
+int mulp_get_lib_params(lib_params_t *lib_params);
+int mulp_set_connection_default_params(unsigned int instanceid, geco_instance_params_t* geco_instance_params);
+int mulp_get_connection_default_params(unsigned int instanceid, geco_instance_params_t* geco_instance_params);
+int mulp_get_connection_params(unsigned int connectionid, connection_infos_t* status);
+int mulp_set_connection_params(unsigned int connectionid, connection_infos_t* new_status);
+int mulp_get_path_params(unsigned int connectionid, short path_id, path_infos_t* status);
+int mulp_set_path_params(unsigned int connectionid, short path_id, path_infos_t *new_status);
+
+/*----------------------------------------------------------------------------------------------*/
+/*                            set cb for transport module                                       */
+/*----------------------------------------------------------------------------------------------*/
+#include <functional>
+typedef std::function<int(void* user_data)> socket_read_start_cb_t;
+typedef std::function<
+    int(int sfd, bool isudpsocket, char* data, int datalen, sockaddrunion* from, sockaddrunion* to, void* user_data)> socket_read_end_cb_t;
+typedef std::function<int(void* user_data)> select_cb_t;
+
+extern void mulp_set_socket_read_handler(socket_read_start_cb_t& mtra_socket_read_start,
+    socket_read_end_cb_t& mtra_socket_read_end, void* start_arg = 0, void* end_args = 0);
+extern void mulp_enable_socket_read_handler();
+extern void mulp_disable_socket_read_handler();
+
+extern void mulp_set_mtra_select_handler(select_cb_t& mtra_select_start, select_cb_t& mtra_select_end, void* start_arg =
+    0, void* end_args = 0);
+extern void mulp_enable_mtra_select_handler();
+extern void mulp_disable_mtra_select_handler();
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef __COMMON_DS_MPSC_QUEUE_H
+#define __COMMON_DS_MPSC_QUEUE_H
+
+#include "spsc-queue.h"
+
+namespace geco
+{
+namespace ds
+{
+/**
+ * bounded lock free ring of elements passed from any number of producer threads to
+ * exactly one consumer thread. every slot carries a sequence number telling whose
+ * turn it is: pos when it is free for the producer claiming position pos, pos + 1
+ * once that producer has written the element, pos + CAPACITY once the consumer has
+ * taken it. producers claim positions with one compare-and-swap on m_nIn and never
+ * wait for each other, the consumer owns m_nOut and needs no atomic operation on it.
+ * a producer that claimed a slot and did not publish it yet holds the consumer back
+ * at that slot, as the elements come out in the order their positions were claimed.
+ */
+template<typename elementType, unsigned int nSize = 128>
+class mpsc_queue_t
+{
+public:
+	/// slots in the ring, nSize rounded up to a power of 2
+	static const unsigned int CAPACITY = spsc_round_up_power2(nSize);
+
+	mpsc_queue_t() :
+			m_pCells(new cell_t[CAPACITY]), m_nIn(0), m_nOut(0)
+	{
+		for (unsigned int i = 0; i < CAPACITY; i++)
+			m_pCells[i].seq.store(i, std::memory_order_relaxed);
+	}
+	virtual ~mpsc_queue_t()
+	{
+		delete[] m_pCells;
+	}
+	mpsc_queue_t(const mpsc_queue_t&) = delete;
+	mpsc_queue_t& operator=(const mpsc_queue_t&) = delete;
+
+	/// any thread
+	/// @return false when the ring is full
+	bool try_push(const elementType& element)
+	{
+		unsigned int pos = m_nIn.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			cell_t& cell = m_pCells[pos & (CAPACITY - 1)];
+			int diff = (int) (cell.seq.load(std::memory_order_acquire) - pos);
+			if (diff == 0)
+			{
+				if (m_nIn.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					cell.element = element;
+					cell.seq.store(pos + 1, std::memory_order_release);
+					return true;
+				}
+			}
+			else if (diff < 0)
+			{
+				// the consumer has not taken the element pushed CAPACITY positions ago
+				return false;
+			}
+			else
+			{
+				// another producer took pos
+				pos = m_nIn.load(std::memory_order_relaxed);
+			}
+		}
+	}
+	/// consumer only
+	/// @return false when the ring is empty or the next element is not published yet
+	bool try_pop(elementType& element)
+	{
+		cell_t& cell = m_pCells[m_nOut & (CAPACITY - 1)];
+		if (cell.seq.load(std::memory_order_acquire) != m_nOut + 1)
+			return false;
+		element = cell.element;
+		cell.seq.store(m_nOut + CAPACITY, std::memory_order_release);
+		m_nOut++;
+		return true;
+	}
+	/// consumer only, pops up to @count elements
+	/// @return number of elements popped
+	unsigned int pop_bulk(elementType* elements, unsigned int count)
+	{
+		unsigned int n = 0;
+		while (n < count && try_pop(elements[n]))
+			n++;
+		return n;
+	}
+	/// consumer only
+	bool IsEmpty() const
+	{
+		return m_pCells[m_nOut & (CAPACITY - 1)].seq.load(std::memory_order_acquire) != m_nOut + 1;
+	}
+
+private:
+	struct cell_t
+	{
+		std::atomic<unsigned int> seq;
+		elementType element;
+	};
+	cell_t* m_pCells; /* read only */
+	char padding1[SPSC_CACHE_LINE_SIZE];
+	std::atomic<unsigned int> m_nIn; /* next position to claim, shared by the producers */
+	char padding2[SPSC_CACHE_LINE_SIZE];
+	unsigned int m_nOut; /* next position to take, consumer only */
+	char padding3[SPSC_CACHE_LINE_SIZE];
+};
+template<typename elementType, unsigned int nSize>
+const unsigned int mpsc_queue_t<elementType, nSize>::CAPACITY;
+}
+}
+#endif
@@ -1,164 +1,179 @@
-#ifndef __COMMON_DS_SCSP_QUEUE_H
-#define __COMMON_DS_SCSP_QUEUE_H
-
-namespace geco
-{
-namespace ds
-{
-template<typename elementType, unsigned int nSize = 128>
-class spsc_queue_t
-{
-public:
-	/// this is used to simulate removeAtIndex()
-	/// when just simple set valid to false to skip this element
-	/// in this way, we do not need push_back locks for remove functions
-	struct Element
-	{
-		elementType ele;
-		bool valid;
-	};
-
-	spsc_queue_t() :
-			m_pBuffer(0), m_nSize(nSize), m_ElementSize(sizeof(elementType)), m_nIn(
-					0), m_nOut(0)
-	{
-		//round up to the next power of 2
-		if (!IsPower2(nSize * m_ElementSize))
-		{
-			m_nSize = RoundUpPower2(nSize * m_ElementSize);
-		}
-		m_pBuffer = (char*) malloc(m_nSize);
-		m_nIn = m_nOut = 0;
-	}
-	virtual ~spsc_queue_t()
-	{
-		if (0 != m_pBuffer)
-		{
-			free(m_pBuffer);
-			m_pBuffer = 0;
-		}
-	}
-
-	void Clear(void)
-	{
-		m_nIn = m_nOut = 0;
-	}
-	unsigned int Size() const
-	{
-		return (m_nIn - m_nOut) / m_ElementSize;
-	}
-	bool IsEmpty()
-	{
-		Size() == 0;
-	}
-	/// These two functions will do whil-loop internally
-	/// until the needed element is returned
-	/// will walways return true;
-	void push_back(const elementType& buffer)
-	{
-		unsigned int m_len = 0;
-		while (m_len < m_ElementSize)
-		{
-			m_len = m_ElementSize - m_len;
-			unsigned int l = m_nSize - m_nIn + m_nOut;
-			m_len = m_len < l ? m_len : l;
-
-			/// Ensure that we sample the m_nOut index -before- we start putting bytes into the UnlockQueue.
-#ifdef _WIN32
-			MemoryBarrier();
-#else
-			__sync_synchronize();
-#endif
-
-			/// first put the data starting from fifo->in to buffer end
-			l = m_nSize - (m_nIn & (m_nSize - 1));
-			l = m_len < l ? m_len : l;
-
-			memcpy(m_pBuffer + (m_nIn & (m_nSize - 1)), &buffer, l);
-			/// then put the rest (if any) at the beginning of the buffer
-			memcpy(m_pBuffer, &buffer + l, m_len - l);
-
-			/// Ensure that we push_back the bytes to the kfifo -before- we update the fifo->in index.
-#ifdef _WIN32
-			MemoryBarrier();
-#else
-			__sync_synchronize();
-#endif
-			m_nIn += m_len;
-		}
-	}
-	void pop_front(elementType& buffer)
-	{
-		unsigned int m_len = 0;
-		while (m_len < m_ElementSize)
-		{
-			m_len = m_ElementSize - m_len;
-			unsigned int l = m_nIn - m_nOut;
-			m_len = m_len < l ? m_len : l;
-
-			/// Ensure that we sample the fifo->in index -before- westart removing bytes from the kfifo.
-#ifdef _WIN32
-			MemoryBarrier();
-#else
-			__sync_synchronize();
-#endif
-			/// first get the data from fifo->out until the end of the buffer
-			l = m_nSize - (m_nOut & (m_nSize - 1));
-			l = m_len < l ? m_len : l;
-
-			memcpy(&buffer, m_pBuffer + (m_nOut & (m_nSize - 1)), l);
-			/// then get the rest (if any) from the beginning of the buffer
-			memcpy(&buffer + l, m_pBuffer, m_len - l);
-
-			/// Ensure that we remove the bytes from the kfifo -before- we update the fifo->out index.
-#ifdef _WIN32
-			MemoryBarrier();
-#else
-			__sync_synchronize();
-#endif
-			m_nOut += m_len;
-		}
-	}
-
-	/// @Notice
-	/// This function can only be used by cosumer thread for thread safe issue
-	/// Caller need check @position is bwtween 0 and Size() before call it
-	elementType& operator[](unsigned int position) const
-	{
-		return *((elementType*) (m_pBuffer + (m_nOut & (m_nSize - 1))
-				+ position * m_ElementSize));
-	}
-
-private:
-	bool IsPower2(unsigned long n)
-	{
-		return (n != 0 && ((n & (n - 1)) == 0));
-	}
-	;
-	unsigned long RoundUpPower2(unsigned long val)
-	{
-		if ((val & (val - 1)) == 0)
-			return val;
-		unsigned long maxulong = (unsigned long) ((unsigned long) ~0);
-		unsigned long andv = ~(maxulong & (maxulong >> 1));
-		while ((andv & val) == 0)
-			andv >>= 1;
-		return andv << 1;
-	}
-
-private:
-	uint64_t padding1[16];
-	unsigned int m_nIn; /* data is added at offset (in % size) */
-	uint64_t padding2[16]; // 128 byte
-	unsigned int m_nOut; /* data is extracted from off. (out % size) */
-	uint64_t padding3[16];
-	char *m_pBuffer; /* the buffer holding the data */
-	uint64_t padding4[16];
-	unsigned int m_nSize; /* the size of the allocated buffer */
-	uint64_t padding5[16];
-	unsigned int m_ElementSize;
-	uint64_t padding6[16];
-};
-}
-}
-#endif
+#ifndef __COMMON_DS_SCSP_QUEUE_H
+#define __COMMON_DS_SCSP_QUEUE_H
+
+#include <atomic>
+#include <thread>
+
+namespace geco
+{
+namespace ds
+{
+#define SPSC_CACHE_LINE_SIZE 64
+
+constexpr unsigned int spsc_round_up_power2(unsigned int val, unsigned int power = 1)
+{
+	return power >= val ? power : spsc_round_up_power2(val, power << 1);
+}
+
+/**
+ * bounded ring of elements passed from exactly one producer thread to exactly one
+ * consumer thread. each index is written by one side only and published with a
+ * release store that the other side reads with an acquire load, so no full barrier
+ * is ever needed. each side keeps a copy of the index of the other side and only
+ * reloads it when the ring looks full (producer) or empty (consumer), so the shared
+ * cache line of the other index is touched once per burst instead of per element.
+ * the indices run freely and wrap, the slot is index & (CAPACITY - 1).
+ */
+template<typename elementType, unsigned int nSize = 128>
+class spsc_queue_t
+{
+public:
+	/// this is used to simulate removeAtIndex()
+	/// when just simple set valid to false to skip this element
+	/// in this way, we do not need push_back locks for remove functions
+	struct Element
+	{
+		elementType ele;
+		bool valid;
+	};
+
+	/// slots in the ring, nSize rounded up to a power of 2
+	static const unsigned int CAPACITY = spsc_round_up_power2(nSize);
+
+	spsc_queue_t() :
+			m_pBuffer(new elementType[CAPACITY]), m_nIn(0), m_nOutCached(0), m_nOut(0), m_nInCached(0)
+	{
+	}
+	virtual ~spsc_queue_t()
+	{
+		delete[] m_pBuffer;
+	}
+	spsc_queue_t(const spsc_queue_t&) = delete;
+	spsc_queue_t& operator=(const spsc_queue_t&) = delete;
+
+	/// consumer only, drops all elements pushed so far
+	void Clear(void)
+	{
+		m_nInCached = m_nIn.load(std::memory_order_acquire);
+		m_nOut.store(m_nInCached, std::memory_order_release);
+	}
+	/// exact on an idle queue, a snapshot while the other side is running
+	unsigned int Size() const
+	{
+		unsigned int out = m_nOut.load(std::memory_order_acquire);
+		return m_nIn.load(std::memory_order_acquire) - out;
+	}
+	bool IsEmpty() const
+	{
+		return Size() == 0;
+	}
+
+	/// producer only
+	/// @return false when the ring is full
+	bool try_push(const elementType& element)
+	{
+		unsigned int in = m_nIn.load(std::memory_order_relaxed);
+		if (in - m_nOutCached == CAPACITY)
+		{
+			m_nOutCached = m_nOut.load(std::memory_order_acquire);
+			if (in - m_nOutCached == CAPACITY)
+				return false;
+		}
+		m_pBuffer[in & (CAPACITY - 1)] = element;
+		m_nIn.store(in + 1, std::memory_order_release);
+		return true;
+	}
+	/// consumer only
+	/// @return false when the ring is empty
+	bool try_pop(elementType& element)
+	{
+		unsigned int out = m_nOut.load(std::memory_order_relaxed);
+		if (out == m_nInCached)
+		{
+			m_nInCached = m_nIn.load(std::memory_order_acquire);
+			if (out == m_nInCached)
+				return false;
+		}
+		element = m_pBuffer[out & (CAPACITY - 1)];
+		m_nOut.store(out + 1, std::memory_order_release);
+		return true;
+	}
+
+	/// producer only, pushes as many of the @count elements as there is room for
+	/// and publishes them all with one store
+	/// @return number of elements pushed
+	unsigned int push_bulk(const elementType* elements, unsigned int count)
+	{
+		unsigned int in = m_nIn.load(std::memory_order_relaxed);
+		unsigned int room = CAPACITY - (in - m_nOutCached);
+		if (room < count)
+		{
+			m_nOutCached = m_nOut.load(std::memory_order_acquire);
+			room = CAPACITY - (in - m_nOutCached);
+			if (count > room)
+				count = room;
+		}
+		for (unsigned int i = 0; i < count; i++)
+			m_pBuffer[(in + i) & (CAPACITY - 1)] = elements[i];
+		if (count > 0)
+			m_nIn.store(in + count, std::memory_order_release);
+		return count;
+	}
+	/// consumer only, pops up to @count elements and frees their slots with one store
+	/// @return number of elements popped
+	unsigned int pop_bulk(elementType* elements, unsigned int count)
+	{
+		unsigned int out = m_nOut.load(std::memory_order_relaxed);
+		unsigned int avail = m_nInCached - out;
+		if (avail < count)
+		{
+			m_nInCached = m_nIn.load(std::memory_order_acquire);
+			avail = m_nInCached - out;
+			if (count > avail)
+				count = avail;
+		}
+		for (unsigned int i = 0; i < count; i++)
+			elements[i] = m_pBuffer[(out + i) & (CAPACITY - 1)];
+		if (count > 0)
+			m_nOut.store(out + count, std::memory_order_release);
+		return count;
+	}
+
+	/// These two functions will do whil-loop internally
+	/// until there is room for the element or an element to return
+	void push_back(const elementType& element)
+	{
+		while (!try_push(element))
+			std::this_thread::yield();
+	}
+	void pop_front(elementType& element)
+	{
+		while (!try_pop(element))
+			std::this_thread::yield();
+	}
+
+	/// @Notice
+	/// This function can only be used by cosumer thread for thread safe issue
+	/// Caller need check @position is bwtween 0 and Size() before call it
+	elementType& operator[](unsigned int position) const
+	{
+		return m_pBuffer[(m_nOut.load(std::memory_order_relaxed) + position) & (CAPACITY - 1)];
+	}
+
+private:
+	// a full line of padding between the fields of each side keeps them on
+	// separate cache lines wherever the queue is allocated
+	elementType* m_pBuffer; /* the buffer holding the data, read only */
+	char padding1[SPSC_CACHE_LINE_SIZE];
+	std::atomic<unsigned int> m_nIn; /* data is added at offset (in % size) */
+	unsigned int m_nOutCached; /* producer copy of m_nOut */
+	char padding2[SPSC_CACHE_LINE_SIZE];
+	std::atomic<unsigned int> m_nOut; /* data is extracted from off. (out % size) */
+	unsigned int m_nInCached; /* consumer copy of m_nIn */
+	char padding3[SPSC_CACHE_LINE_SIZE];
+};
+template<typename elementType, unsigned int nSize>
+const unsigned int spsc_queue_t<elementType, nSize>::CAPACITY;
+}
+}
+#endif
@@ -1,237 +1,397 @@
-/*
- * Geco Gaming Company
- * All Rights Reserved.
- * Copyright (c)  2016 GECOEngine.
- *
- * GECOEngine is free software: you can redistribute it and/or modify
- * it under the terms of the GNU Lesser General Public License as published by
- * the Free Software Foundation, either version 3 of the License, or
- * (at your option) any later version.
- *
- * GECOEngine is distributed in the hope that it will be useful,
- * but WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
- * GNU Lesser General Public License for more details.
-
- * You should have received a copy of the GNU Lesser General Public License
- * along with KBEngine.  If not, see <http://www.gnu.org/licenses/>.
- *
- */
-
-#include "timestamp.h"
-
-#if !defined( _XBOX360) && defined(_WIN32)
-static uint32 processor_mask = 0;
-
-// this function returns an available processor number
-// it favours processorHint, but if this one is not
-// available
-static uint32 availableProcessor(uint32 processorHint)
-{
-	uint32 ret = processorHint;
-	uint count;
-	// First get the available processors
-#ifdef _AMD64_
-	DWORD64 processAffinity = 0;
-	DWORD64 systemAffinity = 0;
-	count = 64;
-	uint64 i;
-#else
-	DWORD processAffinity = 0;
-	DWORD systemAffinity = 0;
-	count = 32;
-	uint32 i;
-#endif
-	HRESULT hr = GetProcessAffinityMask(GetCurrentProcess(), &processAffinity, &systemAffinity);
-	// If hint is available, use it, otherwise find the first available processor
-	if (SUCCEEDED(hr) && !(processAffinity & (1 << processorHint)))
-	{
-		for (i = 0; i < count; i++)
-		{
-			if (processAffinity & (1 << i))
-			{
-				ret = i;
-				break;
-			}
-		}
-	}
-	return ret;
-}
-
-#include <stdio.h>
-void affinity_set(uint32 processorHint)
-{
-	// get an available processor
-	processor_mask = availableProcessor(processorHint);
-	SetThreadAffinityMask(GetCurrentThread(), 1 << processor_mask);
-	if (processor_mask != processorHint)
-	{
-		fprintf(stderr, "ProcessorAffinity::set - unable to set processor "
-			"affinity to %d setting to %d instead\n", processorHint, processor_mask);
-	}
-}
-uint32 affinity_get()
-{
-	return processor_mask;
-}
-void affinity_update()
-{
-	affinity_set(processor_mask);
-}
-#endif
-
-#if defined(PLAYSTATION3)
-static uint64 calc_stamps_pe_sec()
-{
-	return sys_time_get_timebase_frequency();
-}
-#elif defined(_WIN32)
-#ifndef _XBOX360
-#include <windows.h>
-#endif // _XBOX360
-#ifdef GECO_USE_RDTSC
-uint64 g_busyIdleCounter = 0;  // global to avoid over-zealous optimiser
-volatile static bool continueBusyIdle;
-static DWORD WINAPI busy_ldle_thread(LPVOID arg)
-{
-	// Set this thread to run on the first cpu.
-	// We want to throttle up only the cpu that the main thread runs on
-	affinity_update();
-	SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_LOWEST);
-	while (continueBusyIdle) ++g_busyIdleCounter;
-	return 0;
-}
-static uint64 calc_stamps_pe_sec()
-{
-	LARGE_INTEGER tvBefore, tvAfter;
-	DWORD tvSleep = 500;
-	uint64 stampBefore, stampAfter;
-
-	// Set this thread to run on the first cpu.
-	// Timestamps can be out of sync on separate cores/cpu's
-	affinity_update();
-
-	// start a low-priority busy idle thread to use 100% CPU on laptops
-	continueBusyIdle = true;
-	DWORD busyIdleThreadID = 0;
-	HANDLE thread = CreateThread(NULL, 0, &busy_ldle_thread, NULL, 0, &busyIdleThreadID);
-	Sleep(100);// a chance for CPU speed to adjust
-
-	QueryPerformanceCounter(&tvBefore);
-	QueryPerformanceCounter(&tvBefore);
-	QueryPerformanceCounter(&tvBefore);
-	stampBefore = gettimestamp();
-
-	Sleep(tvSleep);
-
-	QueryPerformanceCounter(&tvAfter);
-	QueryPerformanceCounter(&tvAfter);
-	QueryPerformanceCounter(&tvAfter);
-	stampAfter = gettimestamp();
-
-	uint64 countDelta = tvAfter.QuadPart - tvBefore.QuadPart;
-	uint64 stampDelta = stampAfter - stampBefore;
-
-	LARGE_INTEGER frequency;
-	QueryPerformanceFrequency(&frequency);
-
-	continueBusyIdle = false;
-	CloseHandle(thread);
-	return (uint64)((stampDelta * uint64(frequency.QuadPart)) / countDelta);
-	// the multiply above won't overflow until we get over 4THz processors :)
-	//  (assuming the performance counter stays at about 1MHz)
-}
-#else
-static uint64 calc_stamps_pe_sec()
-{
-
-	LARGE_INTEGER ratee;
-	LARGE_INTEGER rate;
-	rate.QuadPart = 0;
-	uint64 count = 1000;
-	for (int i = 0;i < count;i++)
-	{
-		QueryPerformanceFrequency(&ratee);
-		rate.QuadPart += ratee.QuadPart;
-	}
-	return rate.QuadPart / (double)count;
-}
-#endif
-
-#else
-
-#include <sys/time.h>
-#include <sys/types.h>
-#include <unistd.h>
-
-static uint64 calc_stamps_pe_sec()
-{
-	struct timeval tvBefore, tvSleep =
-	{ 0, 500000 }, tvAfter;
-	uint64 stampBefore, stampAfter;
-
-	// Prime it (just in cache)
-	gettimeofday(&tvBefore, NULL);
-	gettimeofday(&tvBefore, NULL);
-	/* If we do these in the same order, then as long as the offset of
-	 the time returned by gettimeofday is consistent, we should be ok. */
-	gettimeofday(&tvBefore, NULL);
-	stampBefore = gettimestamp();
-	select(0, NULL, NULL, NULL, &tvSleep);
-
-	// And again
-	gettimeofday(&tvAfter, NULL);
-	gettimeofday(&tvAfter, NULL);
-	gettimeofday(&tvAfter, NULL);
-	stampAfter = gettimestamp();
-
-	uint64 microDelta = (tvAfter.tv_usec + 1000000 - tvBefore.tv_usec) % 1000000;
-	uint64 stampDelta = stampAfter - stampBefore;
-	return (stampDelta * 1000000ULL) / microDelta;
-	// the multiply above won't overflow until we get over 4THz processors :)
-}
-#endif
-
-uint64 stamps_per_us()
-{
-	static uint64 stampsPerUSCache = ((uint64)(stamps_per_sec_double() / 1000000));
-	return stampsPerUSCache;
-}
-double stamps_per_us_double()
-{
-	static uint64 stampsPerUSCacheD = ((double)(stamps_per_sec_double() / 1000000));
-	return stampsPerUSCacheD;
-}
-
-uint64 stamps_per_ms()
-{
-	static uint64 stampsPerMSCache = ((uint64)(stamps_per_sec_double() / 1000));
-	return stampsPerMSCache;
-}
-double stamps_per_ms_double()
-{
-	static double stampsPerMSCacheD = ((double)(stamps_per_sec_double() / 1000));
-	return stampsPerMSCacheD;
-}
-
-uint64 stamps_per_sec()
-{
-	static uint64 stampsPerSecondCache = calc_stamps_pe_sec();
-	return stampsPerSecondCache;
-}
-double stamps_per_sec_double()
-{
-	static double stampsPerSecondCacheD = double(stamps_per_sec());
-	return stampsPerSecondCacheD;
-}
-double stamps2sec(uint64 stamps)
-{
-	static double val = stamps_per_sec_double();
-	return stamps / val;
-}
-
-time_stamp_t time_stamp_t::fromSecs(double seconds)
-{
-	return uint64(seconds * stamps_per_sec_double());
-}
-
+/*
+ * Geco Gaming Company
+ * All Rights Reserved.
+ * Copyright (c)  2016 GECOEngine.
+ *
+ * GECOEngine is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GECOEngine is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with KBEngine.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "timestamp.h"
+
+#if !defined( _XBOX360) && defined(_WIN32)
+static uint32 processor_mask = 0;
+
+// this function returns an available processor number
+// it favours processorHint, but if this one is not
+// available
+static uint32 availableProcessor(uint32 processorHint)
+{
+	uint32 ret = processorHint;
+	uint count;
+	// First get the available processors
+#ifdef _AMD64_
+	DWORD64 processAffinity = 0;
+	DWORD64 systemAffinity = 0;
+	count = 64;
+	uint64 i;
+#else
+	DWORD processAffinity = 0;
+	DWORD systemAffinity = 0;
+	count = 32;
+	uint32 i;
+#endif
+	HRESULT hr = GetProcessAffinityMask(GetCurrentProcess(), &processAffinity, &systemAffinity);
+	// If hint is available, use it, otherwise find the first available processor
+	if (SUCCEEDED(hr) && !(processAffinity & (1 << processorHint)))
+	{
+		for (i = 0; i < count; i++)
+		{
+			if (processAffinity & (1 << i))
+			{
+				ret = i;
+				break;
+			}
+		}
+	}
+	return ret;
+}
+
+#include <stdio.h>
+void affinity_set(uint32 processorHint)
+{
+	// get an available processor
+	processor_mask = availableProcessor(processorHint);
+	SetThreadAffinityMask(GetCurrentThread(), 1 << processor_mask);
+	if (processor_mask != processorHint)
+	{
+		fprintf(stderr, "ProcessorAffinity::set - unable to set processor "
+			"affinity to %d setting to %d instead\n", processorHint, processor_mask);
+	}
+}
+uint32 affinity_get()
+{
+	return processor_mask;
+}
+void affinity_update()
+{
+	affinity_set(processor_mask);
+}
+#endif
+
+#if defined(PLAYSTATION3)
+static uint64 calc_stamps_pe_sec()
+{
+	return sys_time_get_timebase_frequency();
+}
+#elif defined(_WIN32)
+#ifndef _XBOX360
+#include <windows.h>
+#endif // _XBOX360
+#ifdef GECO_USE_RDTSC
+uint64 g_busyIdleCounter = 0;  // global to avoid over-zealous optimiser
+volatile static bool continueBusyIdle;
+static DWORD WINAPI busy_ldle_thread(LPVOID arg)
+{
+	// Set this thread to run on the first cpu.
+	// We want to throttle up only the cpu that the main thread runs on
+	affinity_update();
+	SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_LOWEST);
+	while (continueBusyIdle) ++g_busyIdleCounter;
+	return 0;
+}
+static uint64 calc_stamps_pe_sec()
+{
+	LARGE_INTEGER tvBefore, tvAfter;
+	DWORD tvSleep = 500;
+	uint64 stampBefore, stampAfter;
+
+	// Set this thread to run on the first cpu.
+	// Timestamps can be out of sync on separate cores/cpu's
+	affinity_update();
+
+	// start a low-priority busy idle thread to use 100% CPU on laptops
+	continueBusyIdle = true;
+	DWORD busyIdleThreadID = 0;
+	HANDLE thread = CreateThread(NULL, 0, &busy_ldle_thread, NULL, 0, &busyIdleThreadID);
+	Sleep(100);// a chance for CPU speed to adjust
+
+	QueryPerformanceCounter(&tvBefore);
+	QueryPerformanceCounter(&tvBefore);
+	QueryPerformanceCounter(&tvBefore);
+	stampBefore = gettimestamp();
+
+	Sleep(tvSleep);
+
+	QueryPerformanceCounter(&tvAfter);
+	QueryPerformanceCounter(&tvAfter);
+	QueryPerformanceCounter(&tvAfter);
+	stampAfter = gettimestamp();
+
+	uint64 countDelta = tvAfter.QuadPart - tvBefore.QuadPart;
+	uint64 stampDelta = stampAfter - stampBefore;
+
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+
+	continueBusyIdle = false;
+	CloseHandle(thread);
+	return (uint64)((stampDelta * uint64(frequency.QuadPart)) / countDelta);
+	// the multiply above won't overflow until we get over 4THz processors :)
+	//  (assuming the performance counter stays at about 1MHz)
+}
+#else
+static uint64 calc_stamps_pe_sec()
+{
+
+	LARGE_INTEGER ratee;
+	LARGE_INTEGER rate;
+	rate.QuadPart = 0;
+	uint64 count = 1000;
+	for (int i = 0;i < count;i++)
+	{
+		QueryPerformanceFrequency(&ratee);
+		rate.QuadPart += ratee.QuadPart;
+	}
+	return rate.QuadPart / (double)count;
+}
+#endif
+
+#else
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef GECO_HAS_TSC
+#include <cpuid.h>
+#endif
+
+#ifdef GECO_HAS_TSC
+/// leaves CLOCK_SOURCE_AUTO once, on the first stamp, frequency query or set_clock_source()
+std::atomic<clock_source_t> g_clock_source(CLOCK_SOURCE_AUTO);
+
+/// @return true when the first line of @path starting with @prefix exists, copied to @line
+static bool read_line(const char* path, const char* prefix, char* line, int size)
+{
+	FILE* file = fopen(path, "r");
+	if (file == NULL)
+		return false;
+	bool found = false;
+	while (!found && fgets(line, size, file) != NULL)
+		found = strncmp(line, prefix, strlen(prefix)) == 0;
+	fclose(file);
+	return found;
+}
+
+/// the tsc ticks at the same rate in all p-states and c-states (constant_tsc and
+/// nonstop_tsc) and the kernel did not find it unsynchronized between cpus
+static bool tsc_is_reliable()
+{
+	static char line[4096];
+	if (read_line("/proc/cpuinfo", "flags", line, sizeof(line)))
+	{
+		if (strstr(line, " constant_tsc") == NULL || strstr(line, " nonstop_tsc") == NULL)
+			return false;
+	}
+	else
+	{
+		// invariant tsc bit, what the kernel reports as both flags
+		uint32 eax, ebx, ecx, edx;
+		if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) || !(edx & (1 << 8)))
+			return false;
+	}
+	if (read_line("/sys/devices/system/clocksource/clocksource0/current_clocksource", "", line, sizeof(line)))
+		return strncmp(line, "tsc", 3) == 0;
+	return true;
+}
+
+static clock_source_t resolve_clock_source()
+{
+	const char* name = getenv("GECO_CLOCK_SOURCE");
+	if (name != NULL && strcmp(name, "tsc") == 0)
+		return CLOCK_SOURCE_TSC;
+	if (name != NULL && strcmp(name, "os") == 0)
+		return CLOCK_SOURCE_OS;
+	return tsc_is_reliable() ? CLOCK_SOURCE_TSC : CLOCK_SOURCE_OS;
+}
+
+clock_source_t get_clock_source()
+{
+	clock_source_t source = g_clock_source.load(std::memory_order_acquire);
+	if (source == CLOCK_SOURCE_AUTO)
+	{
+		// the first stamps may race here, they all resolve the same source
+		static clock_source_t resolved = resolve_clock_source();
+		if (g_clock_source.compare_exchange_strong(source, resolved, std::memory_order_acq_rel))
+			source = resolved;
+	}
+	return source;
+}
+clock_source_t set_clock_source(clock_source_t source)
+{
+	if (source == CLOCK_SOURCE_AUTO)
+		return get_clock_source();
+	// the frequency cached by stamps_per_sec() belongs to the latched source, it is never switched
+	clock_source_t latched = CLOCK_SOURCE_AUTO;
+	if (g_clock_source.compare_exchange_strong(latched, source, std::memory_order_acq_rel))
+		return source;
+	return latched;
+}
+
+uint64 gettimestamp_slow()
+{
+	if (get_clock_source() == CLOCK_SOURCE_TSC)
+		return read_tsc();
+	return read_os_clock();
+}
+
+/// @return the tsc frequency reported by cpuid, a hypervisor or the kernel, 0 if none does
+static uint64 reported_tsc_frequency()
+{
+	uint32 eax, ebx, ecx, edx;
+	// crystal clock frequency times the tsc/crystal ratio
+	if (__get_cpuid_max(0, NULL) >= 0x15)
+	{
+		__cpuid_count(0x15, 0, eax, ebx, ecx, edx);
+		if (eax != 0 && ebx != 0 && ecx != 0)
+			return uint64(ecx) * ebx / eax;
+	}
+	// vmware and kvm report the tsc khz in the timing leaf of their cpuid range
+	__cpuid(1, eax, ebx, ecx, edx);
+	if (ecx & (1u << 31))
+	{
+		__cpuid(0x40000000, eax, ebx, ecx, edx);
+		if (eax >= 0x40000010)
+		{
+			__cpuid(0x40000010, eax, ebx, ecx, edx);
+			if (eax != 0)
+				return uint64(eax) * 1000;
+		}
+	}
+	char line[64];
+	if (read_line("/sys/devices/system/cpu/cpu0/tsc_freq_khz", "", line, sizeof(line)))
+	{
+		uint64 khz = strtoull(line, NULL, 10);
+		if (khz != 0)
+			return khz * 1000;
+	}
+	return 0;
+}
+
+static uint64 raw_clock_ns()
+{
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+	return uint64(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+/// reads CLOCK_MONOTONIC_RAW between two tsc reads, keeping the tightest of a few tries
+/// so an interrupt in between does not skew the pair
+static void read_clock_pair(uint64* tsc, uint64* ns)
+{
+	uint64 best = UINT64_MAX;
+	for (int i = 0; i < 5; i++)
+	{
+		uint64 before = read_tsc();
+		uint64 now = raw_clock_ns();
+		uint64 after = read_tsc();
+		if (after - before < best)
+		{
+			best = after - before;
+			*tsc = before + (after - before) / 2;
+			*ns = now;
+		}
+	}
+}
+static uint64 calibrate_tsc_frequency()
+{
+	uint64 tsc_before, ns_before, tsc_after, ns_after;
+	read_clock_pair(&tsc_before, &ns_before);
+	while (raw_clock_ns() - ns_before < TSC_CALIBRATION_MS * 1000000ULL)
+		;
+	read_clock_pair(&tsc_after, &ns_after);
+	return (tsc_after - tsc_before) * 1000000000ULL / (ns_after - ns_before);
+	// the multiply above won't overflow until the window reaches 4 seconds of a 4GHz tsc
+}
+
+static uint64 calc_stamps_pe_sec()
+{
+	if (get_clock_source() == CLOCK_SOURCE_OS)
+		return 1000000000ULL;
+	uint64 frequency = reported_tsc_frequency();
+	return frequency != 0 ? frequency : calibrate_tsc_frequency();
+}
+#else
+clock_source_t get_clock_source()
+{
+	return CLOCK_SOURCE_OS;
+}
+clock_source_t set_clock_source(clock_source_t source)
+{
+	return get_clock_source();
+}
+static uint64 calc_stamps_pe_sec()
+{
+	return 1000000000ULL;
+}
+#endif
+#endif
+
+#if defined(PLAYSTATION3) || defined(_WIN32)
+clock_source_t get_clock_source()
+{
+#if defined(_WIN32) && defined(GECO_USE_RDTSC)
+	return CLOCK_SOURCE_TSC;
+#else
+	return CLOCK_SOURCE_OS;
+#endif
+}
+clock_source_t set_clock_source(clock_source_t source)
+{
+	return get_clock_source();
+}
+#endif
+
+uint64 stamps_per_us()
+{
+	static uint64 stampsPerUSCache = ((uint64)(stamps_per_sec_double() / 1000000));
+	return stampsPerUSCache;
+}
+double stamps_per_us_double()
+{
+	static double stampsPerUSCacheD = ((double)(stamps_per_sec_double() / 1000000));
+	return stampsPerUSCacheD;
+}
+
+uint64 stamps_per_ms()
+{
+	static uint64 stampsPerMSCache = ((uint64)(stamps_per_sec_double() / 1000));
+	return stampsPerMSCache;
+}
+double stamps_per_ms_double()
+{
+	static double stampsPerMSCacheD = ((double)(stamps_per_sec_double() / 1000));
+	return stampsPerMSCacheD;
+}
+
+uint64 stamps_per_sec()
+{
+	static uint64 stampsPerSecondCache = calc_stamps_pe_sec();
+	return stampsPerSecondCache;
+}
+double stamps_per_sec_double()
+{
+	static double stampsPerSecondCacheD = double(stamps_per_sec());
+	return stampsPerSecondCacheD;
+}
+double stamps2sec(uint64 stamps)
+{
+	static double val = stamps_per_sec_double();
+	return stamps / val;
+}
+
+time_stamp_t time_stamp_t::fromSecs(double seconds)
+{
+	return uint64(seconds * stamps_per_sec_double());
+}
+
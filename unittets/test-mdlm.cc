@@ -13,6 +13,9 @@
 
 #include "geco-net-chunk.h"
 #include "geco-net.h"
+#include "geco-net-auth.h"
+#include <iostream>
+#include <vector>
 
 struct mdlm : public testing::Test
 {
@@ -27,7 +30,7 @@ struct mdlm : public testing::Test
 	{
 		GLOBAL_CURR_EVENT_LOG_LEVEL = INFO;
 		alloc_geco_channel();
-		init_channel_ = curr_channel_;
+		init_channel_ = mdi_ctx_.curr_channel;
 		mdlm_ = init_channel_->deliverman_control;
 		init_mdlm_ = *mdlm_;
 		mrecv_ = init_channel_->receive_control;
@@ -42,8 +45,8 @@ struct mdlm : public testing::Test
 		reset()
 	{
 		//reset everything to its init valuess
-		curr_channel_ = init_channel_;
-		curr_geco_instance_ = curr_channel_->geco_inst;
+		mdi_ctx_.curr_channel = init_channel_;
+		mdi_ctx_.curr_geco_instance = mdi_ctx_.curr_channel->geco_inst;
 		mdlm_ = init_channel_->deliverman_control;
 		*mdlm_ = init_mdlm_;
 		mrecv_ = init_channel_->receive_control;
@@ -99,7 +102,7 @@ TEST_F(mdlm, test_mdlm_process_dchunk_ur_us_t)
 	ret = mdlm_receive_dchunk(mdlm_, chunk, addr_idx);
 	//then should abort current channel
 	ASSERT_EQ(ret, -18); // MULP_NO_USER_DATA=-18
-	ASSERT_EQ(curr_channel_, nullptr);
+	ASSERT_EQ(mdi_ctx_.curr_channel, nullptr);
 	this->SetUp();
 
 	//when dchunk_ur_s is segmented and pdu not zero
@@ -112,11 +115,136 @@ TEST_F(mdlm, test_mdlm_process_dchunk_ur_us_t)
 	ret = mdlm_receive_dchunk(mdlm_, chunk, addr_idx);
 	//then should abort current channel
 	ASSERT_EQ(ret, -19); // MULP_PROTOCOL_VIOLATION=-19
-	ASSERT_EQ(curr_channel_, nullptr);
+	ASSERT_EQ(mdi_ctx_.curr_channel, nullptr);
 	mch_free_simple_chunk(id);
 	this->SetUp();
 }
 
+extern void
+mdlm_free_delivery_pdu(delivery_pdu_t* d_pdu);
+TEST_F(mdlm, test_mdlm_steady_state_no_allocation)
+{
+	uchar chunkflag = FLAG_TBIT_UNSET | DCHUNK_FLAG_UNRELIABLE | DCHUNK_FLAG_UNSEQ
+		| DCHUNK_FLAG_FIRST_FRAG | DCHUNK_FLAG_LAST_FRG;
+	chunk_id_t id = mch_make_simple_chunk(CHUNK_DATA, chunkflag);
+	curr_write_pos_[id] = 32;
+	dchunk_ur_us_t* chunk = (dchunk_ur_us_t*)mch_complete_simple_chunk(id);
+
+	// the first round fills the pools, after that receive and delivery only recycle
+	size_t allocs = 0;
+	for (int round = 0; round < 2; round++)
+	{
+		allocs = geco_malloc_thread_alloc_count();
+		for (int i = 0; i < 1000; i++)
+		{
+			ASSERT_EQ(mdlm_receive_dchunk(mdlm_, chunk, 0), 0);
+			delivery_pdu_t* d_pdu = mdlm_->ur_pduList.front();
+			mdlm_->ur_pduList.pop_front();
+			mdlm_->queued_bytes -= d_pdu->total_length;
+			mdlm_free_delivery_pdu(d_pdu);
+		}
+	}
+	ASSERT_EQ(geco_malloc_thread_alloc_count(), allocs);
+	mch_free_simple_chunk(id);
+}
+
+extern delivery_data_t*
+mdlm_alloc_delivery_data(uint data_length);
+extern void
+mdlm_free_delivery_data(delivery_data_t* dchunk);
+extern internal_data_chunk_t*
+mdi_alloc_data_chunk(uint chunk_len);
+extern void
+mdi_free_data_chunk(internal_data_chunk_t* chunk);
+/// bytes of the profiled blocks not freed yet, of the sites in @file only if given
+static size_t heap_live_bytes(const char* file = NULL)
+{
+	std::vector<geco_heap_site_t> sites(geco_heap_profiler_snapshot(NULL, 0) + 64);
+	size_t n = geco_heap_profiler_snapshot(sites.data(), sites.size());
+	size_t live = 0;
+	for (size_t i = 0; i < n && i < sites.size(); i++)
+		if (file == NULL || strstr(sites[i].file, file) != NULL)
+			live += sites[i].live_bytes;
+	return live;
+}
+TEST_F(mdlm, test_delivery_data_memory_report)
+{
+	// before, every queued chunk carried a full packet sized payload array
+	const size_t fixed_bytes = DELIVERY_DATA_FIXED_SIZE + MAX_NETWORK_PACKET_VALUE_SIZE;
+	const size_t fixed_send_bytes = INTERNAL_DATA_CHUNK_FIXED_SIZE + MAX_NETWORK_PACKET_VALUE_SIZE;
+	// more than a pool may hold free so at least half of the chunks come from the allocator
+	const uint chunks = 2 * OBJECT_POOL_HIGH_WATERMARK;
+	const uint payloads[] = { 0, 20, 64, 65, 200, 256, 257, 1000, MAX_NETWORK_PACKET_VALUE_SIZE };
+	bool was_profiling = geco_heap_profiler_enabled();
+	geco_heap_profiler_enable(true);
+
+	// a channel and its instance made while profiling, the pools and the channel table may keep
+	// what they grew by, the blocks of the channel itself are allocated by the dispatcher
+	free_geco_channel();
+	size_t live = heap_live_bytes();
+	size_t channel_live = heap_live_bytes("geco-net-dispatch");
+	alloc_geco_channel();
+	size_t channel_bytes = heap_live_bytes("geco-net-dispatch") - channel_live;
+	std::cout << "channel with its instance: " << channel_bytes << " bytes, "
+		<< heap_live_bytes() - live << " bytes with pool and table growth\n";
+	ASSERT_GT(channel_bytes, 0u);
+
+	std::vector<delivery_data_t*> dchunks(chunks);
+	std::vector<internal_data_chunk_t*> idchunks(chunks);
+	for (uint payload : payloads)
+	{
+		size_t tier = payload <= SMALL_CHUNK_DATA_SIZE ? SMALL_CHUNK_DATA_SIZE :
+			payload <= MEDIUM_CHUNK_DATA_SIZE ? MEDIUM_CHUNK_DATA_SIZE : payload;
+		// chunks queued for delivery
+		size_t start = live = heap_live_bytes();
+		for (uint i = 0; i < chunks; i++)
+		{
+			dchunks[i] = mdlm_alloc_delivery_data(payload);
+			ASSERT_NE(dchunks[i], (delivery_data_t*)NULL);
+			ASSERT_EQ(dchunks[i]->data_length, payload);
+			memset(dchunks[i]->data, 0xab, payload); // the whole payload must be writable
+		}
+		size_t recv_bytes = heap_live_bytes() - live;
+		// chunks queued for sending
+		live = heap_live_bytes();
+		for (uint i = 0; i < chunks; i++)
+		{
+			idchunks[i] = mdi_alloc_data_chunk(payload);
+			ASSERT_NE(idchunks[i], (internal_data_chunk_t*)NULL);
+			memset(idchunks[i]->data, 0xab, payload);
+		}
+		size_t send_bytes = heap_live_bytes() - live;
+		std::cout << "payload " << payload << " bytes: " << fixed_bytes << " bytes per queued chunk before, "
+			<< recv_bytes / chunks << " bytes delivered, " << send_bytes / chunks << " bytes sent now\n";
+		ASSERT_GE(recv_bytes, (chunks - OBJECT_POOL_HIGH_WATERMARK) * (DELIVERY_DATA_FIXED_SIZE + tier));
+		ASSERT_LE(recv_bytes, chunks * (DELIVERY_DATA_FIXED_SIZE + tier));
+		ASSERT_LE(recv_bytes, chunks * fixed_bytes);
+		ASSERT_GE(send_bytes, (chunks - OBJECT_POOL_HIGH_WATERMARK) * (INTERNAL_DATA_CHUNK_FIXED_SIZE + tier));
+		ASSERT_LE(send_bytes, chunks * (INTERNAL_DATA_CHUNK_FIXED_SIZE + tier));
+		ASSERT_LE(send_bytes, chunks * fixed_send_bytes);
+
+		// all given back but what the pools keep free
+		for (uint i = 0; i < chunks; i++)
+		{
+			mdlm_free_delivery_data(dchunks[i]);
+			mdi_free_data_chunk(idchunks[i]);
+		}
+		size_t pooled = payload > MEDIUM_CHUNK_DATA_SIZE ? 0 :
+			OBJECT_POOL_HIGH_WATERMARK * (DELIVERY_DATA_FIXED_SIZE + INTERNAL_DATA_CHUNK_FIXED_SIZE + 2 * tier);
+		ASSERT_LE(heap_live_bytes(), start + pooled);
+	}
+
+	// pooled objects are tagged by the dispatcher too, with the pools grown a channel leaves nothing
+	free_geco_channel();
+	channel_live = heap_live_bytes("geco-net-dispatch");
+	alloc_geco_channel();
+	free_geco_channel();
+	ASSERT_EQ(heap_live_bytes("geco-net-dispatch"), channel_live);
+	alloc_geco_channel(); // for TearDown()
+	init_channel_ = mdi_ctx_.curr_channel;
+	geco_heap_profiler_enable(was_profiling);
+}
+
 extern int
 mdlm_receive_dchunk(deliverman_controller_t* mdlm, dchunk_ur_s_t* dataChunk,
 	ushort address_index);
@@ -141,7 +269,7 @@ TEST_F(mdlm, test_mdlm_process_dchunk_ur_s_t)
 	int ret = mdlm_receive_dchunk(mdlm_, chunk, addr_idx);
 	//then should create a delivery_pdu and add it to mdlm->ur_pduList
 	ASSERT_EQ(ret, -17); //MULP_INVALID_STREAM_ID=-17
-	ASSERT_EQ(curr_channel_, nullptr);
+	ASSERT_EQ(mdi_ctx_.curr_channel, nullptr);
 
 	mch_free_simple_chunk(id);
 	this->SetUp();
@@ -149,15 +277,15 @@ TEST_F(mdlm, test_mdlm_process_dchunk_ur_s_t)
 	//when pdu_len = 0 and stream_identity<numSequencedStreams
 	pdu_len = 0;
 	id = mch_make_simple_chunk(CHUNK_DATA, chunkflag);
-	chunk->data_chunk_hdr.stream_identity = htons(
-		mdlm_->numSequencedStreams - 1);
 	curr_write_pos_[id] = DCHUNK_UR_SEQ_FIXED_SIZE; // write dchunk_ur fixed size
 	curr_write_pos_[id] += pdu_len;
 	chunk = (dchunk_ur_s_t*)mch_complete_simple_chunk(id);
+	chunk->data_chunk_hdr.stream_identity = htons(
+		mdlm_->numSequencedStreams - 1);
 	ret = mdlm_receive_dchunk(mdlm_, chunk, addr_idx);
 	//then should abort current channel
 	ASSERT_EQ(ret, -18); // MULP_NO_USER_DATA=-18
-	ASSERT_EQ(curr_channel_, nullptr);
+	ASSERT_EQ(mdi_ctx_.curr_channel, nullptr);
 	mch_free_simple_chunk(id);
 	this->SetUp();
 
@@ -174,7 +302,7 @@ TEST_F(mdlm, test_mdlm_process_dchunk_ur_s_t)
 	ret = mdlm_receive_dchunk(mdlm_, chunk, addr_idx);
 	//then should abort current channel
 	ASSERT_EQ(ret, -19); // MULP_PROTOCOL_VIOLATION=-19
-	ASSERT_EQ(curr_channel_, nullptr);
+	ASSERT_EQ(mdi_ctx_.curr_channel, nullptr);
 	mch_free_simple_chunk(id);
 	this->SetUp();
 
@@ -187,10 +315,10 @@ TEST_F(mdlm, test_mdlm_process_dchunk_ur_s_t)
 		| DCHUNK_FLAG_FIRST_FRAG | DCHUNK_FLAG_LAST_FRG;
 	pdu_len = 32;
 	id = mch_make_simple_chunk(CHUNK_DATA, chunkflag);
-	chunk->data_chunk_hdr.stream_identity = htons(sid);
 	curr_write_pos_[id] = DCHUNK_UR_SEQ_FIXED_SIZE; // write dchunk_ur fixed size
 	curr_write_pos_[id] += pdu_len;
 	chunk = (dchunk_ur_s_t*)mch_complete_simple_chunk(id);
+	chunk->data_chunk_hdr.stream_identity = htons(sid);
 
 	//and when last_ssn_used=true,recv_stream->last_ssn=0,ssn=2 != 0+1
 	recv_stream->last_ssn_used = true;
@@ -199,7 +327,7 @@ TEST_F(mdlm, test_mdlm_process_dchunk_ur_s_t)
 	ret = mdlm_receive_dchunk(mdlm_, chunk, addr_idx);
 	//then should discard the chunk
 	ASSERT_EQ(ret, -19); // MULP_PROTOCOL_VIOLATION=-19
-	ASSERT_EQ(curr_channel_, nullptr);
+	ASSERT_EQ(mdi_ctx_.curr_channel, nullptr);
 	mch_free_simple_chunk(id);
 	this->SetUp();
 
@@ -209,11 +337,11 @@ TEST_F(mdlm, test_mdlm_process_dchunk_ur_s_t)
 	recv_stream->next_expected_ssn = 3;
 	pdu_len = 32;
 	id = mch_make_simple_chunk(CHUNK_DATA, chunkflag);
-	chunk->data_chunk_hdr.stream_identity = htons(sid);
-	chunk->data_chunk_hdr.stream_seq_num = htons(2);
 	curr_write_pos_[id] = DCHUNK_UR_SEQ_FIXED_SIZE; // write dchunk_ur fixed size
 	curr_write_pos_[id] += pdu_len;
 	chunk = (dchunk_ur_s_t*)mch_complete_simple_chunk(id);
+	chunk->data_chunk_hdr.stream_identity = htons(sid);
+	chunk->data_chunk_hdr.stream_seq_num = htons(2);
 	ret = mdlm_receive_dchunk(mdlm_, chunk, addr_idx);
 	//then should discard the chunk
 	ASSERT_EQ(ret, 0); // MULP_SUCCESS=0
@@ -226,11 +354,11 @@ TEST_F(mdlm, test_mdlm_process_dchunk_ur_s_t)
 	recv_stream->next_expected_ssn = 0;
 	pdu_len = 32;
 	id = mch_make_simple_chunk(CHUNK_DATA, chunkflag);
-	chunk->data_chunk_hdr.stream_identity = sid;
-	chunk->data_chunk_hdr.stream_seq_num = htons(ssn);
 	curr_write_pos_[id] = DCHUNK_UR_SEQ_FIXED_SIZE; // write dchunk_ur fixed size
 	curr_write_pos_[id] += pdu_len;
 	chunk = (dchunk_ur_s_t*)mch_complete_simple_chunk(id);
+	chunk->data_chunk_hdr.stream_identity = sid;
+	chunk->data_chunk_hdr.stream_seq_num = htons(ssn);
 	ret = mdlm_receive_dchunk(mdlm_, chunk, addr_idx);
 	//then should add the chunk
 	ASSERT_EQ(ret, 0); // MULP_SUCCESS=0
@@ -243,11 +371,11 @@ TEST_F(mdlm, test_mdlm_process_dchunk_ur_s_t)
 	//and and when ssn(1) == recv_stream->last_ssn(0)+1
 	ssn = 1;
 	id = mch_make_simple_chunk(CHUNK_DATA, chunkflag);
-	chunk->data_chunk_hdr.stream_identity = sid;
-	chunk->data_chunk_hdr.stream_seq_num = htons(ssn);
 	curr_write_pos_[id] = DCHUNK_UR_SEQ_FIXED_SIZE; // write dchunk_ur fixed size
 	curr_write_pos_[id] += pdu_len;
 	chunk = (dchunk_ur_s_t*)mch_complete_simple_chunk(id);
+	chunk->data_chunk_hdr.stream_identity = sid;
+	chunk->data_chunk_hdr.stream_seq_num = htons(ssn);
 	ret = mdlm_receive_dchunk(mdlm_, chunk, addr_idx);
 	//then should add the chunk
 	ASSERT_EQ(ret, 0); // MULP_SUCCESS=0
@@ -265,15 +393,15 @@ TEST_F(mdlm, test_mdlm_process_dchunk_ur_s_t)
 	//and and when ssn(3) != recv_stream->last_ssn(1)+1=2
 	ssn = 3;
 	id = mch_make_simple_chunk(CHUNK_DATA, chunkflag);
-	chunk->data_chunk_hdr.stream_identity = sid;
-	chunk->data_chunk_hdr.stream_seq_num = htons(ssn);
 	curr_write_pos_[id] = DCHUNK_UR_SEQ_FIXED_SIZE; // write dchunk_ur fixed size
 	curr_write_pos_[id] += pdu_len;
 	chunk = (dchunk_ur_s_t*)mch_complete_simple_chunk(id);
+	chunk->data_chunk_hdr.stream_identity = sid;
+	chunk->data_chunk_hdr.stream_seq_num = htons(ssn);
 	ret = mdlm_receive_dchunk(mdlm_, chunk, addr_idx);
 	//then should abort connection
 	ASSERT_EQ(ret, -19); // MULP_PROTOCOL_VIOLATION=-19
-	ASSERT_EQ(curr_channel_, nullptr);
+	ASSERT_EQ(mdi_ctx_.curr_channel, nullptr);
 	mch_free_simple_chunk(id);
 	this->SetUp();
 }
@@ -359,4 +487,236 @@ TEST_F(mdlm, test_mdlm_reassemble_pdu_frags)
 	ASSERT_TRUE(mrecv_->datagram_has_reliable_dchunk);
 	ASSERT_EQ(mrecv_->duplicated_data_chunks_list.size(), 0);
 	ASSERT_EQ(mrecv_->highest_duplicate_tsn, tsn);
-}
\ No newline at end of file
+}
+extern void
+mdlm_set_compression(deliverman_controller_t* mdlm, bool enable);
+extern uint
+mdlm_compress_msg(deliverman_controller_t* mdlm, ushort sid, uchar* chunk_flags, const uchar* msg, uint len,
+	uchar* out);
+extern void
+mdlm_deliver_completed_pdu_frags(deliverman_controller_t* mdlm);
+TEST_F(mdlm, test_mdlm_compressed_msg_round_trip)
+{
+	// given sequenced game state messages listing entities of the same layout
+	ASSERT_EQ(mulp_set_compression(init_channel_->channel_id + 1, true), MULP_ASSOC_NOT_FOUND);
+	ASSERT_EQ(mulp_set_compression(init_channel_->channel_id, true), MULP_SUCCESS);
+	ASSERT_TRUE(mdlm_->compress_msgs);
+	uchar msg[600];
+	uchar out[600];
+	uint raw_bytes = 0, sent_bytes = 0, compressed_msgs = 0;
+	for (uint n = 0; n < 200; n++)
+	{
+		uint len = n % 50 == 0 ? 600 : 64 + n % 40;
+		for (uint j = 0; j < len; j++)
+			msg[j] = j % 16 == 7 ? (uchar)('a' + (j / 16 + n) % 26) : (uchar)"entity x hp 100 "[j % 16];
+
+		// when the message goes through the send stage
+		uchar chunk_flags = DCHUNK_FLAG_URS | DCHUNK_FLAG_FIRST_FRAG | DCHUNK_FLAG_LAST_FRG;
+		uint size = mdlm_compress_msg(mdlm_, 0, &chunk_flags, msg, len, out);
+		ASSERT_EQ(size > 0, (chunk_flags & DCHUNK_FLAG_COMPRESSED) != 0);
+		ASSERT_LT(size, len);
+		raw_bytes += len;
+		sent_bytes += size > 0 ? size : len;
+		compressed_msgs += size > 0;
+
+		// and is delivered by the peer
+		uint chunk_len = size > 0 ? size : len;
+		delivery_data_t* dchunk = mdlm_alloc_delivery_data(chunk_len);
+		memcpy(dchunk->data, size > 0 ? out : msg, chunk_len);
+		dchunk->stream_id = 0;
+		dchunk->stream_sn = (ushort)n;
+		dchunk->tsn = UT_ITSN + n;
+		dchunk->from_addr_index = 0;
+		dchunk->chunk_flags = chunk_flags;
+		delivery_pdu_t* d_pdu = GECO_MALLOC_EXT(delivery_pdu_t, 1);
+		d_pdu->number_of_chunks = 1;
+		d_pdu->data = dchunk;
+		d_pdu->total_length = chunk_len;
+		mdlm_->queued_bytes += chunk_len;
+		mdlm_->recv_seq_streams[0].prePduList.push_back(d_pdu);
+		mdlm_deliver_completed_pdu_frags(mdlm_);
+
+		// then the user reads the original message, whether the messages before it arrived or not
+		ASSERT_EQ(mdlm_->recv_seq_streams[0].pduList.size(), 1);
+		ASSERT_EQ(mdlm_->recv_seq_streams[0].pduList.front(), d_pdu);
+		ASSERT_EQ(d_pdu->total_length, len);
+		ASSERT_EQ(d_pdu->data->chunk_flags & DCHUNK_FLAG_COMPRESSED, 0);
+		ASSERT_EQ(memcmp(d_pdu->data->data, msg, len), 0);
+		mdlm_->recv_seq_streams[0].pduList.clear();
+		mdlm_free_delivery_data(d_pdu->data);
+		geco_free_ext(d_pdu, __FILE__, __LINE__);
+	}
+	std::cout << compressed_msgs << " of 200 messages compressed, " << raw_bytes << " bytes sent as "
+		<< sent_bytes << " bytes\n";
+	ASSERT_GT(compressed_msgs, 150);
+	ASSERT_EQ(mdlm_->queued_bytes, 0);
+	ASSERT_EQ(mulp_set_compression(init_channel_->channel_id, false), MULP_SUCCESS);
+	ASSERT_FALSE(mdlm_->compress_msgs);
+}
+
+extern bool
+mdlm_decompress_pdu(delivery_pdu_t* dpdu);
+TEST_F(mdlm, test_mdlm_decompress_caps_claimed_length)
+{
+	// given a message of runs that expands to LZ_MAX_MSG_SIZE
+	uchar msg[LZ_MAX_MSG_SIZE + 1];
+	uchar out[LZ_MAX_MSG_SIZE + 1];
+	memset(msg, 'a', sizeof(msg));
+	mdlm_set_compression(mdlm_, true);
+	uchar chunk_flags = DCHUNK_FLAG_UNRELIABLE | DCHUNK_FLAG_FIRST_FRAG | DCHUNK_FLAG_LAST_FRG;
+	uint size = mdlm_compress_msg(mdlm_, 0, &chunk_flags, msg, LZ_MAX_MSG_SIZE, out);
+	mdlm_set_compression(mdlm_, false);
+	ASSERT_GT(size, 0);
+
+	for (uint claimed = LZ_MAX_MSG_SIZE; claimed <= LZ_MAX_MSG_SIZE + 1; claimed++)
+	{
+		delivery_pdu_t dpdu;
+		dpdu.number_of_chunks = 1;
+		dpdu.data = mdlm_alloc_delivery_data(size);
+		memcpy(dpdu.data->data, out, size);
+		dpdu.data->chunk_flags = chunk_flags;
+		dpdu.total_length = size;
+		uint len = htonl(claimed);
+		memcpy(dpdu.data->data, &len, LZ_MSG_HEADER_SIZE);
+		if (claimed == LZ_MAX_MSG_SIZE)
+		{
+			// then it is delivered
+			ASSERT_TRUE(mdlm_decompress_pdu(&dpdu));
+			ASSERT_EQ(dpdu.total_length, LZ_MAX_MSG_SIZE);
+			ASSERT_EQ(memcmp(dpdu.data->data, msg, LZ_MAX_MSG_SIZE), 0);
+		}
+		else
+		{
+			// but a claimed length beyond it is malformed, though the input could expand to it
+			ASSERT_LE(claimed / LZ_MAX_MATCH, size);
+			ASSERT_FALSE(mdlm_decompress_pdu(&dpdu));
+			ASSERT_EQ(dpdu.total_length, size);
+		}
+		mdlm_free_delivery_data(dpdu.data);
+	}
+}
+
+TEST_F(mdlm, test_mdlm_incompressible_msgs_bypass)
+{
+	// given random messages
+	mdlm_set_compression(mdlm_, true);
+	uchar msg[200];
+	uchar out[200];
+	uint tried = 0;
+	for (uint n = 0; n < LZ_BYPASS_POOR_MSGS + LZ_BYPASS_SKIP_MSGS; n++)
+	{
+		for (uint j = 0; j < sizeof(msg); j++)
+			msg[j] = (uchar)generate_random_uint32();
+		tried += mdlm_->lz_bypass.skip_msgs == 0;
+		uchar chunk_flags = DCHUNK_FLAG_UNRELIABLE | DCHUNK_FLAG_FIRST_FRAG | DCHUNK_FLAG_LAST_FRG;
+		ASSERT_EQ(mdlm_compress_msg(mdlm_, 0, &chunk_flags, msg, sizeof(msg), out), 0);
+		ASSERT_EQ(chunk_flags & DCHUNK_FLAG_COMPRESSED, 0);
+	}
+	// then the messages stop being tried after LZ_BYPASS_POOR_MSGS poor results, until
+	// LZ_BYPASS_SKIP_MSGS messages went raw
+	ASSERT_EQ(tried, LZ_BYPASS_POOR_MSGS);
+	ASSERT_EQ(mdlm_->lz_bypass.skip_msgs, 0);
+	mdlm_set_compression(mdlm_, false);
+}
+
+static std::vector<mulp_data_arrive_t> arrivals_;
+static std::vector<std::string> arrived_msgs_;
+static uint arrive_batches_;
+static void
+on_data_arrive_batch(const mulp_data_arrive_t* arrivals, uint count, void* user_data)
+{
+	arrive_batches_++;
+	for (uint i = 0; i < count; i++)
+	{
+		arrivals_.push_back(arrivals[i]);
+		arrived_msgs_.push_back(std::string((const char*)arrivals[i].data, arrivals[i].length));
+	}
+}
+static delivery_data_t*
+make_dchunk(const char* msg, ushort sid, ushort ssn, uint tsn)
+{
+	uint len = strlen(msg);
+	delivery_data_t* dchunk = mdlm_alloc_delivery_data(len);
+	memcpy(dchunk->data, msg, len);
+	dchunk->stream_id = sid;
+	dchunk->stream_sn = ssn;
+	dchunk->tsn = tsn;
+	dchunk->from_addr_index = 0;
+	dchunk->chunk_flags = DCHUNK_FLAG_RO;
+	return dchunk;
+}
+TEST_F(mdlm, test_batched_data_arrive_notification)
+{
+	// given batched delivery
+	arrivals_.clear();
+	arrived_msgs_.clear();
+	arrive_batches_ = 0;
+	mulp_set_data_arrive_batch_cb(on_data_arrive_batch, NULL);
+
+	// when messages complete on two ordered streams, one of them in two fragments,
+	// and an unordered one arrives
+	const char* msgs[] = { "move 1", "move 2", "move 3", "chat 1", "chat 2", "ping" };
+	for (uint n = 0; n < 5; n++)
+	{
+		ushort sid = n < 3 ? 0 : 1;
+		delivery_pdu_t* d_pdu = GECO_MALLOC_EXT(delivery_pdu_t, 1);
+		if (n == 2)
+		{
+			d_pdu->number_of_chunks = 2;
+			d_pdu->ddata = GECO_MALLOC_EXT(delivery_data_t*, 2);
+			d_pdu->ddata[0] = make_dchunk("move", sid, n, UT_ITSN + n);
+			d_pdu->ddata[0]->chunk_flags |= DCHUNK_FLAG_FIRST_FRAG;
+			d_pdu->ddata[1] = make_dchunk(" 3", sid, n, UT_ITSN + n + 1);
+			d_pdu->ddata[1]->chunk_flags |= DCHUNK_FLAG_LAST_FRG;
+		}
+		else
+		{
+			d_pdu->number_of_chunks = 1;
+			d_pdu->data = make_dchunk(msgs[n], sid, n, UT_ITSN + n);
+			d_pdu->data->chunk_flags |= DCHUNK_FLAG_FIRST_FRAG | DCHUNK_FLAG_LAST_FRG;
+		}
+		d_pdu->total_length = strlen(msgs[n]);
+		mdlm_->queued_bytes += d_pdu->total_length;
+		mdlm_->recv_order_streams[sid].prePduList.push_back(d_pdu);
+	}
+	delivery_pdu_t* ur_pdu = GECO_MALLOC_EXT(delivery_pdu_t, 1);
+	ur_pdu->number_of_chunks = 1;
+	ur_pdu->data = make_dchunk(msgs[5], 0, 0, UT_ITSN + 6);
+	ur_pdu->data->chunk_flags = DCHUNK_FLAG_UNRELIABLE | DCHUNK_FLAG_FIRST_FRAG | DCHUNK_FLAG_LAST_FRG;
+	ur_pdu->total_length = strlen(msgs[5]);
+	mdlm_->queued_bytes += ur_pdu->total_length;
+	mdlm_->ur_pduList.push_back(ur_pdu);
+	mdlm_deliver_completed_pdu_frags(mdlm_);
+
+	// then nothing is notified before the end of the poll
+	ASSERT_EQ(arrive_batches_, 0);
+	mdi_flush_data_arrivals();
+
+	// then the poll hands all messages over at once, each stream in order
+	ASSERT_EQ(arrive_batches_, 1);
+	ASSERT_EQ(arrivals_.size(), 6);
+	for (uint n = 0; n < 5; n++)
+	{
+		ASSERT_EQ(arrivals_[n].connectionid, init_channel_->channel_id);
+		ASSERT_EQ(arrivals_[n].streamID, n < 3 ? 0 : 1);
+		ASSERT_EQ(arrivals_[n].streamSN, n);
+		ASSERT_EQ(arrivals_[n].length, strlen(msgs[n]));
+		ASSERT_EQ(arrivals_[n].unordered, 0);
+		ASSERT_EQ(arrived_msgs_[n], msgs[n]);
+	}
+	ASSERT_EQ(arrivals_[5].unordered, 1);
+	ASSERT_EQ(arrived_msgs_[5], msgs[5]);
+
+	// then the delivered messages are freed, none stays queued or is delivered again
+	for (uint sid = 0; sid < 2; sid++)
+	{
+		ASSERT_TRUE(mdlm_->recv_order_streams[sid].prePduList.empty());
+		ASSERT_TRUE(mdlm_->recv_order_streams[sid].pduList.empty());
+	}
+	ASSERT_TRUE(mdlm_->ur_pduList.empty());
+	ASSERT_EQ(mdlm_->queued_bytes, 0);
+	mdlm_deliver_completed_pdu_frags(mdlm_);
+	mdi_flush_data_arrivals();
+	ASSERT_EQ(arrive_batches_, 1);
+	mulp_set_data_arrive_batch_cb(NULL, NULL);
+}
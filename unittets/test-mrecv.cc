@@ -23,7 +23,7 @@ struct mrecv : public testing::Test
 	{
 		GLOBAL_CURR_EVENT_LOG_LEVEL = INFO;
 		alloc_geco_channel();
-		init_channel_ = curr_channel_;
+		init_channel_ = mdi_ctx_.curr_channel;
 		mrecv_ = init_channel_->receive_control;
 		init_mrecv_ = *mrecv_;
 	}
@@ -36,8 +36,8 @@ struct mrecv : public testing::Test
 		reset()
 	{
 		//reset everything to its init valuess
-		curr_channel_ = init_channel_;
-		curr_geco_instance_ = curr_channel_->geco_inst;
+		mdi_ctx_.curr_channel = init_channel_;
+		mdi_ctx_.curr_geco_instance = mdi_ctx_.curr_channel->geco_inst;
 		mrecv_ = init_channel_->receive_control;
 		*mrecv_ = init_mrecv_;
 	}
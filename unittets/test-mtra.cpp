@@ -1,571 +1,1425 @@
-#include "gtest/gtest.h"
-#include "gmock/gmock.h"
-// @caution because geco-ds-malloc includes geco-thread.h that includes window.h but transport_layer.h includes wsock2.h, as we know, it must include before windows.h so if you uncomment this line, will cause error
-//#include "geco-ds-malloc.h"
-#include "geco-net-transport.h"
-#include "geco-net-common.h"
-#include "geco-ds-malloc.h"
-#include "geco-malloc.h"
-using namespace geco::ds;
-
-#include "geco-net-config.h"
-#include "geco-net.h"
-//#include "timeout-debug.h"
-#include "wheel-timer.h"
-
-#ifdef _WIN32
-#define mysleep Sleep
-#else
-#define mysleep sleep
-#endif
-
-extern int mtra_icmp_rawsock_; /* socket fd for ICMP messages */
-extern int socket_despts_size_;
-extern socket_despt_t socket_despts[MAX_FD_SIZE];
-extern event_handler_t event_callbacks[MAX_FD_SIZE];
-
-extern void
-mtra_set_expected_event_on_fd(int fd_index, int sfd, int event_mask);
-extern void
-mtra_set_expected_event_on_fd(int sfd, int eventcb_type, int event_mask,
-	cbunion_t action, void* userData);
-extern void
-mtra_add_stdin_cb(stdin_data_t::stdin_cb_func_t stdincb);
-extern int
-mtra_poll(int maxwait = -1);
-extern int
-mtra_remove_stdin_cb();
-extern int
-mtra_remove_event_handler(int sfd);
-extern int
-mtra_read_ip4rawsock();
-extern int
-mtra_read_ip6rawsock();
-extern int
-mtra_read_icmp_socket();
-extern int
-mtra_init(int * myRwnd);
-extern timeouts*
-mtra_read_timeouts();
-
-struct alloc_t
-{
-	void* ptr;
-	size_t allocsize;
-};
-
-TEST(test_case_logging, test_read_trace_levels)
-{
-	read_trace_levels();
-}
-
-TEST(TIMER_MODULE, test_operations_on_time)
-{
-	timeval tv;
-	fills_timeval(&tv, 1000);
-	EXPECT_TRUE(tv.tv_sec == 1);
-	EXPECT_TRUE(tv.tv_usec == 0);
-
-	timeval result;
-	sum_time(&tv, (time_t)200, &result);
-	//print_timeval(&result);
-	EXPECT_TRUE(result.tv_sec == 1);
-	EXPECT_TRUE(result.tv_usec == 200000);
-
-	sum_time(&result, (time_t)0, &result);
-	//print_timeval(&result);
-	EXPECT_TRUE(result.tv_sec == 1);
-	EXPECT_TRUE(result.tv_usec == 200000);
-
-	sum_time(&result, (time_t)1, &result);
-	//print_timeval(&result);
-	EXPECT_TRUE(result.tv_sec == 1);
-	EXPECT_TRUE(result.tv_usec == 201000);
-
-	sum_time(&result, (time_t)1000, &result);
-	//print_timeval(&result);
-	EXPECT_TRUE(result.tv_sec == 2);
-	EXPECT_TRUE(result.tv_usec == 201000);
-
-	sum_time(&result, (time_t)800, &result);
-	//print_timeval(&result);
-	EXPECT_TRUE(result.tv_sec == 3);
-	EXPECT_TRUE(result.tv_usec == 1000);
-
-	subtract_time(&result, (time_t)800, &result);
-	//print_timeval(&result);
-	EXPECT_TRUE(result.tv_sec == 2);
-	EXPECT_TRUE(result.tv_usec == 201000);
-
-	subtract_time(&result, (time_t)201, &result);
-	//print_timeval(&result);
-	EXPECT_TRUE(result.tv_sec == 2);
-	EXPECT_TRUE(result.tv_usec == 0);
-
-	subtract_time(&result, (time_t)0, &result);
-	//print_timeval(&result);
-	EXPECT_TRUE(result.tv_sec == 2);
-	EXPECT_TRUE(result.tv_usec == 0);
-
-	subtract_time(&result, 2000, &result);
-	//print_timeval(&result);
-	EXPECT_TRUE(result.tv_sec == 0);
-	EXPECT_TRUE(result.tv_usec == 0);
-}
-// last run on 21 Agu 2016 and passed
-TEST(GLOBAL_MODULE, test_saddr_str)
-{
-	sockaddrunion saddr;
-	str2saddr(&saddr, "192.168.1.107", 38000);
-
-	char ret[MAX_IPADDR_STR_LEN];
-	ushort port = 0;
-	saddr2str(&saddr, ret, sizeof(ret), &port);
-	EVENTLOG1(VERBOSE, "saddr {%s}\n", ret);
-	EXPECT_EQ(saddr.sa.sa_family, AF_INET);
-	EXPECT_EQ(strcmp(ret, "192.168.1.107"), 0);
-	EXPECT_EQ(port, 38000);
-
-	sockaddrunion saddr1;
-	str2saddr(&saddr1, "192.168.1.107", 38000);
-	sockaddrunion saddr2;
-	str2saddr(&saddr2, "192.168.1.107", 38000);
-	EXPECT_EQ(saddr_equals(&saddr1, &saddr2), true);
-
-	str2saddr(&saddr1, "192.167.1.125", 38000);
-	str2saddr(&saddr2, "192.168.1.107", 38000);
-	EXPECT_EQ(saddr_equals(&saddr1, &saddr2), false);
-
-	str2saddr(&saddr1, "192.168.1.107", 3800);
-	str2saddr(&saddr2, "192.168.1.107", 38000);
-	EXPECT_EQ(saddr_equals(&saddr1, &saddr2), false);
-
-	str2saddr(&saddr1, "192.168.1.125", 3800);
-	str2saddr(&saddr2, "192.168.1.107", 38000);
-	EXPECT_EQ(saddr_equals(&saddr1, &saddr2), false);
-}
-
-// last run on 27 Agu 2016 and passed
-TEST(MALLOC_MODULE, test_geco_new_delete)
-{
-	int j;
-	int total = 1000000;
-	/*max is 5120 we use 5121 to have the max*/
-	size_t allocsize;
-	size_t dealloc_idx;
-	std::list<alloc_t*> allos;
-	std::list<alloc_t*>::iterator it;
-
-	int alloccnt = 0;
-	int deallcnt = 0;
-	alloc_t* at;
-	for (j = 0; j < total; j++)
-	{
-		if (rand() % 2)
-		{
-
-			uint s = ((rand() * UINT32_MAX) % 1024) + 1;
-			at = geco_new_array<alloc_t>(s, __FILE__, __LINE__);
-			at->allocsize = s;
-			allos.push_back(at);
-			alloccnt += s;
-		}
-		else
-		{
-			size_t s = allos.size();
-			if (s > 0)
-			{
-				dealloc_idx = (rand() % s);
-				it = allos.begin();
-				std::advance(it, dealloc_idx);
-				deallcnt += (*it)->allocsize;
-				geco_delete_array<alloc_t>(*it, __FILE__, __LINE__);
-				allos.erase(it);
-			}
-		}
-	}
-	for (auto& p : allos)
-	{
-		deallcnt += p->allocsize;
-		geco_delete_array<alloc_t>(p, __FILE__, __LINE__);
-	}
-	allos.clear();
-	EXPECT_EQ(alloccnt, deallcnt);
-	EXPECT_EQ(allos.size(), 0);
-}
-TEST(MALLOC_MODULE, test_geco_alloc_dealloc)
-{
-	int j;
-	int total = 1000000;
-	/*max is 5120 we use 5121 to have the max*/
-	size_t allocsize;
-	size_t dealloc_idx;
-	std::list<alloc_t> allos;
-	std::list<alloc_t>::iterator it;
-
-	int alloccnt = 0;
-	int deallcnt = 0;
-	int less_than_max_byte_cnt = 0;
-	int zero_alloc_cnt = 0;
-	alloc_t at;
-	for (j = 0; j < total; j++)
-	{
-		if (rand() % 2)
-		{
-			allocsize = (rand() * UINT32_MAX) % 2049;
-			if (allocsize <= 1512)
-				++less_than_max_byte_cnt;
-			if (allocsize == 0)
-				++zero_alloc_cnt;
-			at.ptr = geco_malloc_ext(allocsize, __FILE__, __LINE__);
-			at.allocsize = allocsize;
-			allos.push_back(at);
-			alloccnt++;
-		}
-		else
-		{
-			size_t s = allos.size();
-			if (s > 0)
-			{
-				dealloc_idx = rand() % s;
-				it = allos.begin();
-				std::advance(it, dealloc_idx);
-				geco_free_ext(it->ptr, __FILE__, __LINE__);
-				allos.erase(it);
-				deallcnt++;
-			}
-		}
-	}
-	for (auto& p : allos)
-	{
-		geco_free_ext(p.ptr, __FILE__, __LINE__);
-		deallcnt++;
-	}
-	allos.clear();
-	EXPECT_EQ(alloccnt, deallcnt);
-	EXPECT_EQ(allos.size(), 0);
-	EVENTLOG5(VERBOSE,
-		"alloccnt %d, dealloccnt %d, < 1512 cnt %d, %d, zer alloc cnt %d\n",
-		alloccnt, deallcnt, less_than_max_byte_cnt,
-		alloccnt - less_than_max_byte_cnt, zero_alloc_cnt);
-}
-// last run on 21 Agu 2016 and passed
-TEST(MALLOC_MODULE, test_alloc_dealloc)
-{
-	single_client_alloc allocator;
-	int j;
-	int total = 1000000;
-	/*max is 5120 we use 5121 to have the max*/
-	size_t allocsize;
-	size_t dealloc_idx;
-	std::list<alloc_t> allos;
-	std::list<alloc_t>::iterator it;
-
-	int alloccnt = 0;
-	int deallcnt = 0;
-	int less_than_max_byte_cnt = 0;
-	int zero_alloc_cnt = 0;
-	alloc_t at;
-	for (j = 0; j < total; j++)
-	{
-		if (rand() % 2)
-		{
-			allocsize = (rand() * UINT32_MAX) % 2049;
-			if (allocsize <= 1512)
-				++less_than_max_byte_cnt;
-			if (allocsize == 0)
-				++zero_alloc_cnt;
-			at.ptr = allocator.allocate(allocsize);
-			at.allocsize = allocsize;
-			allos.push_back(at);
-			alloccnt++;
-		}
-		else
-		{
-			size_t s = allos.size();
-			if (s > 0)
-			{
-				dealloc_idx = rand() % s;
-				it = allos.begin();
-				std::advance(it, dealloc_idx);
-				allocator.deallocate(it->ptr, it->allocsize);
-				allos.erase(it);
-				deallcnt++;
-			}
-		}
-	}
-	for (auto& p : allos)
-	{
-		allocator.deallocate(p.ptr, p.allocsize);
-		deallcnt++;
-	}
-	allos.clear();
-	allocator.destroy();
-	EXPECT_EQ(alloccnt, deallcnt);
-	EXPECT_EQ(allos.size(), 0);
-	EVENTLOG5(VERBOSE,
-		"alloccnt %d, dealloccnt %d, < 1512 cnt %d, %d, zer alloc cnt %d\n",
-		alloccnt, deallcnt, less_than_max_byte_cnt,
-		alloccnt - less_than_max_byte_cnt, zero_alloc_cnt);
-}
-
-// last pass on 26 Oct 2016
-TEST(AUTH_MODULE, test_md5)
-{
-	unsigned char digest[HMAC_LEN];
-	MD5_CTX ctx;
-
-	const char* testdata = "202cb962ac59075b964b07152d234b70";
-	const char* result = "d9b1d7db4cd6e70935368a1efb10e377";
-	MD5Init(&ctx);
-	MD5Update(&ctx, (uchar*)testdata, strlen(testdata));
-	MD5Final(digest, &ctx);
-	EVENTLOG1(VERBOSE, "Computed MD5 signature : %s",
-		hexdigest(digest, HMAC_LEN));
-	EXPECT_STREQ(hexdigest(digest, 16), result);
-
-	testdata = "d9b1d7db4cd6e70935368a1efb10e377";
-	result = "7363a0d0604902af7b70b271a0b96480";
-	MD5Init(&ctx);
-	MD5Update(&ctx, (uchar*)testdata, strlen(testdata));
-	MD5Final(digest, &ctx);
-	EVENTLOG1(VERBOSE, "Computed MD5 signature : %s",
-		hexdigest(digest, HMAC_LEN));
-	EXPECT_STREQ(hexdigest(digest, 16), result);
-}
-TEST(AUTH_MODULE, test_sockaddr2hashcode)
-{
-	uint ret;
-	sockaddrunion localsu;
-	str2saddr(&localsu, "192.168.1.107", 36000);
-	sockaddrunion peersu;
-	str2saddr(&peersu, "192.168.1.107", 36000);
-	ret = transportaddr2hashcode(&localsu, &peersu);
-	EVENTLOG2(
-		VERBOSE,
-		"hash(addr pair { localsu: 192.168.1.107:36001 peersu: 192.168.1.107:36000 }) = %u, %u",
-		ret, ret % 100000);
-
-	str2saddr(&localsu, "192.168.1.107", 1234);
-	str2saddr(&peersu, "192.168.1.107", 360);
-	ret = transportaddr2hashcode(&localsu, &peersu);
-	EVENTLOG2(
-		VERBOSE,
-		"hash(addr pair { localsu: 192.168.1.107:36001 peersu: 192.168.1.107:36000 }) = %u, %u",
-		ret, ret % 100000);
-}
-TEST(AUTH_MODULE, test_crc32_checksum)
-{
-	for (int ii = 0; ii < 100; ii++)
-	{
-		geco_packet_t geco_packet;
-		geco_packet.pk_comm_hdr.checksum = 0;
-		geco_packet.pk_comm_hdr.dest_port = htons(
-			(generate_random_uint32() % USHRT_MAX));
-		geco_packet.pk_comm_hdr.src_port = htons(
-			(generate_random_uint32() % USHRT_MAX));
-		geco_packet.pk_comm_hdr.verification_tag = htons(
-			(generate_random_uint32()));
-		((chunk_fixed_t*)geco_packet.chunk)->chunk_id = CHUNK_DATA;
-		((chunk_fixed_t*)geco_packet.chunk)->chunk_length = htons(100);
-		((chunk_fixed_t*)geco_packet.chunk)->chunk_flags =
-			DCHUNK_FLAG_UNORDER | DCHUNK_FLAG_FL_FRG;
-		for (int i = 0; i < 100; i++)
-		{
-			uchar* wt = geco_packet.chunk + CHUNK_FIXED_SIZE;
-			wt[i] = generate_random_uint32() % UCHAR_MAX;
-		}
-		set_crc32_checksum((char*)&geco_packet, DCHUNK_R_O_S_FIXED_SIZES + 100);
-		bool ret = validate_crc32_checksum((char*)&geco_packet,
-			DCHUNK_R_O_S_FIXED_SIZES + 100);
-		EXPECT_TRUE(ret);
-	}
-}
-
-static bool flag = true;
-static char inputs[1024];
-static int len;
-static void
-stdin_cb(char* data, size_t datalen)
-{
-	EVENTLOG2(DEBUG, "stdin_cb()::%d bytes : %s", datalen, inputs);
-
-	memcpy(inputs, data, datalen);
-	if (strcmp(data, "q") == 0)
-	{
-		flag = false;
-		return;
-	}
-
-	int sentsize;
-	uchar tos = IPTOS_DEFAULT;
-	sockaddrunion saddr;
-
-	str2saddr(&saddr, "::1", USED_UDP_PORT);
-	sentsize = mtra_send_rawsock_ip6(mtra_read_ip6rawsock(), inputs, datalen,
-		&saddr, tos);
-	assert(sentsize == datalen);
-	EXPECT_STRCASEEQ(data, inputs);
-
-	str2saddr(&saddr, "127.0.0.1", USED_UDP_PORT);
-	sentsize = mtra_send_rawsock_ip4(mtra_read_ip4rawsock(), inputs, datalen,
-		&saddr, tos);
-	assert(sentsize == datalen);
-	EXPECT_STRCASEEQ(data, inputs);
-
-	str2saddr(&saddr, "::1", USED_UDP_PORT);
-	sentsize = mtra_send_udpsock_ip6(mtra_read_ip6udpsock(), inputs, datalen,
-		&saddr, tos);
-	assert(sentsize == datalen);
-	EXPECT_STRCASEEQ(data, inputs);
-
-	str2saddr(&saddr, "127.0.0.1", USED_UDP_PORT);
-	sentsize = mtra_send_udpsock_ip4(mtra_read_ip4udpsock(), inputs, datalen,
-		&saddr, tos);
-	assert(sentsize == datalen);
-	EXPECT_STRCASEEQ(data, inputs);
-}
-static void
-socket_cb(int sfd, char* data, int datalen, sockaddrunion* from,
-	sockaddrunion* to)
-{
-	EXPECT_STRCASEEQ(data, inputs);
-
-	static char fromstr[MAX_IPADDR_STR_LEN];
-	static char tostr[MAX_IPADDR_STR_LEN];
-	ushort fport;
-	ushort tport;
-	saddr2str(from, fromstr, MAX_IPADDR_STR_LEN, &fport);
-	saddr2str(to, tostr, MAX_IPADDR_STR_LEN, &tport);
-
-	if (sfd == mtra_read_ip4rawsock())
-	{
-		EVENTLOG8(
-			DEBUG,
-			"socket_cb(ip%d raw fd=%d)::receive (%d) bytes  of data(%s) from addr (%s:%d) to addr (%s:%d)",
-			4, sfd, datalen, data, fromstr, fport, tostr, tport);
-	}
-	else if (sfd == mtra_read_ip6rawsock())
-	{
-		EVENTLOG8(
-			DEBUG,
-			"socket_cb(ip%d raw fd=%d)::receive (%d) bytes  of data(%s) from addr (%s:%d) to addr (%s:%d)",
-			6, sfd, datalen, data, fromstr, fport, tostr, tport);
-	}
-	else if (sfd == mtra_read_ip6udpsock())
-	{
-		EVENTLOG8(
-			DEBUG,
-			"socket_cb(ip%d udp fd=%d)::receive (%d) bytes  of data(%s) from addr (%s:%d) to addr (%s:%d)",
-			6, sfd, datalen, data, fromstr, fport, tostr, tport);
-	}
-	else if (sfd == mtra_read_ip4udpsock())
-	{
-		EVENTLOG8(
-			DEBUG,
-			"socket_cb(ip%d udp fd=%d)::receive (%d) bytes  of data(%s) from addr (%s:%d) to addr (%s:%d)",
-			4, sfd, datalen, data, fromstr, fport, tostr, tport);
-	}
-	else
-	{
-		EVENTLOG(DEBUG, "NO SUCH SFD");
-	}
-}
-
-static int
-wheel_timer_cb(timeout* id)
-{
-	EVENTLOG(DEBUG, "wheel timer timeouts, BYE!");
-	//flag = false;
-	return true;
-}
-
-static void
-task_cb(void* userdata)
-{
-	static int counter = 0;
-	counter++;
-	if (counter > 300)
-	{
-		EVENTLOG1(DEBUG,
-			"task_cb called 300 times with tick of 10ms(userdata = %s)",
-			(char*)userdata);
-		counter = 0;
-	}
-}
-
-int
-socket_read_start(void* user_data)
-{
-	printf("socket read starts\n");
-	return 0;
-}
-int
-socket_read_end(int sfd, bool isudpsocket, char* data, int datalen,
-	sockaddrunion* from, sockaddrunion* to, void* user_data)
-{
-	printf("socket read end sfd=%d,isudpsocket=%d,datalen=%d ... \n", sfd,
-		isudpsocket, datalen);
-	return 0;
-}
-int
-select_start(void* user_data)
-{
-	printf("select_start\n");
-	return 0;
-}
-int
-select_end(void* user_data)
-{
-	printf("select_end\n");
-	mulp_disable_mtra_select_handler();
-	return 0;
-}
-
-#include "wheel-timer.h"
-
-TEST(TRANSPORT_MODULE, test_process_stdin)
-{
-	int rcwnd = 512;
-	mtra_init(&rcwnd);
-
-	cbunion_t cbunion;
-	cbunion.socket_cb_fun = socket_cb;
-	mtra_set_expected_event_on_fd(mtra_read_ip4rawsock(),
-		EVENTCB_TYPE_SCTP,
-		POLLIN | POLLPRI, cbunion, 0);
-	mtra_set_expected_event_on_fd(mtra_read_ip4udpsock(),
-		EVENTCB_TYPE_UDP,
-		POLLIN | POLLPRI, cbunion, 0);
-	mtra_set_expected_event_on_fd(mtra_read_ip6rawsock(),
-		EVENTCB_TYPE_SCTP,
-		POLLIN | POLLPRI, cbunion, 0);
-	mtra_set_expected_event_on_fd(mtra_read_ip6udpsock(),
-		EVENTCB_TYPE_UDP,
-		POLLIN | POLLPRI, cbunion, 0);
-
-	//you have to put stdin as last because we test it
-	mtra_add_stdin_cb(stdin_cb);
-	//mtra_set_tick_task_cb (task_cb, (void*) "this is user datta");
-
-	timeout* tout = (timeout*)geco_malloc_ext(sizeof(timeout), __FILE__, __LINE__);
-	tout->callback.action = &wheel_timer_cb;
-	tout->callback.type = TIMER_TYPE_INIT;
-	tout->flags = TIMEOUT_INT;
-	timeouts_add(mtra_read_timeouts(), tout, 1800 * stamps_per_sec());
-
-	socket_read_start_cb_t mtra_socket_read_start = socket_read_start;
-	socket_read_end_cb_t mtra_socket_read_end = socket_read_end;
-	mulp_set_socket_read_handler(mtra_socket_read_start, mtra_socket_read_end);
-	mulp_enable_socket_read_handler();
-
-	select_cb_t mtra_select_start = select_start;
-	select_cb_t mtra_select_end = select_end;
-	mulp_set_mtra_select_handler(mtra_select_start, mtra_select_end);
-	mulp_enable_mtra_select_handler();
-
-	while (flag)
-		mtra_poll();
-	mtra_destroy();
-}
-
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+// @caution because geco-ds-malloc includes geco-thread.h that includes window.h but transport_layer.h includes wsock2.h, as we know, it must include before windows.h so if you uncomment this line, will cause error
+//#include "geco-ds-malloc.h"
+#include "geco-net-transport.h"
+#include "geco-net-common.h"
+#include "geco-ds-malloc.h"
+#include "geco-malloc.h"
+#include "geco-bit-stream.h"
+#include "geco-net-lz.h"
+using namespace geco::ds;
+
+#include "geco-net-config.h"
+#include "geco-net.h"
+//#include "timeout-debug.h"
+#include "wheel-timer.h"
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#define mysleep Sleep
+#else
+#define mysleep sleep
+#endif
+
+extern thread_local int mtra_icmp_rawsock_; /* socket fd for ICMP messages */
+extern thread_local int socket_despts_size_;
+extern thread_local socket_despt_t socket_despts[MAX_FD_SIZE];
+extern thread_local event_handler_t event_callbacks[MAX_FD_SIZE];
+
+extern void
+mtra_set_expected_event_on_fd(int fd_index, int sfd, int event_mask);
+extern void
+mtra_set_expected_event_on_fd(int sfd, int eventcb_type, int event_mask,
+	cbunion_t action, void* userData);
+extern void
+mtra_add_stdin_cb(stdin_data_t::stdin_cb_func_t stdincb);
+extern int
+mtra_poll(int maxwait = -1);
+extern int
+mtra_remove_stdin_cb();
+extern int
+mtra_remove_event_handler(int sfd);
+extern int
+mtra_read_ip4rawsock();
+extern int
+mtra_read_ip6rawsock();
+extern int
+mtra_read_icmp_socket();
+extern int
+mtra_init(int * myRwnd);
+extern timeouts*
+mtra_read_timeouts();
+
+struct alloc_t
+{
+	void* ptr;
+	size_t allocsize;
+};
+
+TEST(test_case_logging, test_read_trace_levels)
+{
+	read_trace_levels();
+}
+
+TEST(TIMER_MODULE, test_operations_on_time)
+{
+	timeval tv;
+	fills_timeval(&tv, 1000);
+	EXPECT_TRUE(tv.tv_sec == 1);
+	EXPECT_TRUE(tv.tv_usec == 0);
+
+	timeval result;
+	sum_time(&tv, (time_t)200, &result);
+	//print_timeval(&result);
+	EXPECT_TRUE(result.tv_sec == 1);
+	EXPECT_TRUE(result.tv_usec == 200000);
+
+	sum_time(&result, (time_t)0, &result);
+	//print_timeval(&result);
+	EXPECT_TRUE(result.tv_sec == 1);
+	EXPECT_TRUE(result.tv_usec == 200000);
+
+	sum_time(&result, (time_t)1, &result);
+	//print_timeval(&result);
+	EXPECT_TRUE(result.tv_sec == 1);
+	EXPECT_TRUE(result.tv_usec == 201000);
+
+	sum_time(&result, (time_t)1000, &result);
+	//print_timeval(&result);
+	EXPECT_TRUE(result.tv_sec == 2);
+	EXPECT_TRUE(result.tv_usec == 201000);
+
+	sum_time(&result, (time_t)800, &result);
+	//print_timeval(&result);
+	EXPECT_TRUE(result.tv_sec == 3);
+	EXPECT_TRUE(result.tv_usec == 1000);
+
+	subtract_time(&result, (time_t)800, &result);
+	//print_timeval(&result);
+	EXPECT_TRUE(result.tv_sec == 2);
+	EXPECT_TRUE(result.tv_usec == 201000);
+
+	subtract_time(&result, (time_t)201, &result);
+	//print_timeval(&result);
+	EXPECT_TRUE(result.tv_sec == 2);
+	EXPECT_TRUE(result.tv_usec == 0);
+
+	subtract_time(&result, (time_t)0, &result);
+	//print_timeval(&result);
+	EXPECT_TRUE(result.tv_sec == 2);
+	EXPECT_TRUE(result.tv_usec == 0);
+
+	subtract_time(&result, 2000, &result);
+	//print_timeval(&result);
+	EXPECT_TRUE(result.tv_sec == 0);
+	EXPECT_TRUE(result.tv_usec == 0);
+}
+extern thread_local timeouts* tos_;
+static int embedded_timer_cb(timeout* tout)
+{
+	return 0;
+}
+TEST(TIMER_MODULE, test_embedded_timer_wheel_ops)
+{
+	// a wheel of its own, the library need not be initialised
+	timeouts* saved = tos_;
+	int err;
+	tos_ = timeouts_open(0, &err);
+	const uint packets = 100000;
+	const uint rto = 1000;
+
+	// allocated timers are freed and added again for every sent packet
+	size_t allocs = geco_malloc_thread_alloc_count();
+	uint64 ops = mtra_read_wheel_ops();
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	timeout* tout = mtra_timeouts_add(TIMER_TYPE_RTXM, rto, &embedded_timer_cb);
+	for (uint n = 1; n < packets; n++)
+	{
+		mtra_timeouts_del(tout);
+		tout = mtra_timeouts_add(TIMER_TYPE_RTXM, rto, &embedded_timer_cb);
+	}
+	mtra_timeouts_del(tout);
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+	std::cout << "allocated timers: " << (double)(mtra_read_wheel_ops() - ops) / packets << " wheel ops and "
+		<< (double)(geco_malloc_thread_alloc_count() - allocs) / packets << " allocs per packet, took "
+		<< std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << "us.\n";
+
+	// embedded timers are moved in place
+	timeout t3;
+	mtra_timeout_init(&t3, TIMER_TYPE_RTXM, &embedded_timer_cb);
+	EXPECT_FALSE(mtra_timeout_armed(&t3));
+	allocs = geco_malloc_thread_alloc_count();
+	ops = mtra_read_wheel_ops();
+	start = std::chrono::steady_clock::now();
+	for (uint n = 0; n < packets; n++)
+		mtra_timeout_start(&t3, rto);
+	end = std::chrono::steady_clock::now();
+	EXPECT_EQ(mtra_read_wheel_ops() - ops, 2ull * packets - 1);
+	EXPECT_EQ(geco_malloc_thread_alloc_count(), allocs);
+	std::cout << "embedded timers: " << (double)(mtra_read_wheel_ops() - ops) / packets
+		<< " wheel ops per packet, took " << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()
+		<< "us.\n";
+	mtra_timeouts_stop(&t3);
+	EXPECT_FALSE(mtra_timeout_armed(&t3));
+
+	// lazily rearmed ones only touch the wheel when the deadline moves earlier
+	ops = mtra_read_wheel_ops();
+	start = std::chrono::steady_clock::now();
+	for (uint n = 0; n < packets; n++)
+		mtra_timeout_start_lazy(&t3, rto);
+	end = std::chrono::steady_clock::now();
+	EXPECT_EQ(mtra_read_wheel_ops() - ops, 1u);
+	EXPECT_EQ(geco_malloc_thread_alloc_count(), allocs);
+	std::cout << "lazily rearmed embedded timers: " << (double)(mtra_read_wheel_ops() - ops) / packets
+		<< " wheel ops per packet, took " << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()
+		<< "us.\n";
+	EXPECT_GE(t3.deadline, t3.expires);
+
+	timeout_t expires = t3.expires;
+	mtra_timeout_start_lazy(&t3, 2 * rto);
+	EXPECT_EQ(t3.expires, expires);
+	EXPECT_GT(t3.deadline, expires);
+	mtra_timeout_start_lazy(&t3, 1);
+	EXPECT_LT(t3.expires, expires);
+	EXPECT_EQ(t3.expires, t3.deadline);
+	mtra_timeouts_del(&t3);
+	EXPECT_FALSE(mtra_timeout_armed(&t3));
+
+	timeouts_close(tos_);
+	tos_ = saved;
+}
+static std::vector<std::pair<timeout*, timeout_t>> mux_fired_;
+static timeout_t mux_tick_;
+static int mux_fired_cb(timeout* tout)
+{
+	mux_fired_.push_back(std::make_pair(tout, mux_tick_));
+	return 0;
+}
+TEST(TIMER_MODULE, test_channel_timer_mux)
+{
+	timeouts* saved = tos_;
+	int err;
+	tos_ = timeouts_open(0, &err);
+	timeout_t now = gettimestamp() / (stamps_per_ms() * WHEEL_TICK_MS);
+	timeouts_update(tos_, now);
+	mux_fired_.clear();
+
+	// given the timers of a channel sharing one wheel entry
+	timer_mux_t mux;
+	timeout timers[TIMER_MUX_MAX_TIMERS + 1];
+	mtra_timer_mux_init(&mux);
+	for (uint i = 0; i <= TIMER_MUX_MAX_TIMERS; i++)
+	{
+		mtra_timeout_init(&timers[i], TIMER_TYPE_USER, &mux_fired_cb);
+		mtra_timer_mux_attach(&mux, &timers[i]);
+	}
+	mtra_timeout_start(&timers[0], 30);
+	mtra_timeout_start(&timers[1], 10);
+	mtra_timeout_start(&timers[2], 20);
+	EXPECT_TRUE(mtra_timeout_armed(&timers[1]));
+	EXPECT_EQ(timers[1].pending, nullptr);
+	EXPECT_EQ(mux.wheel.expires, timers[1].deadline);
+
+	// when the earliest one is restarted later, the entry stays where it is
+	uint64 ops = mtra_read_wheel_ops();
+	mtra_timeout_start(&timers[1], 50);
+	EXPECT_EQ(mtra_read_wheel_ops(), ops);
+	EXPECT_LT(mux.wheel.expires, timers[1].deadline);
+
+	// when one more is stopped, it never fires
+	mtra_timeout_start(&timers[3], 5);
+	mtra_timeouts_stop(&timers[3]);
+	EXPECT_FALSE(mtra_timeout_armed(&timers[3]));
+
+	// then the timers fire in deadline order, each in the tick of its deadline
+	for (mux_tick_ = now + 1; mux_tick_ <= now + 60 / WHEEL_TICK_MS + 1; mux_tick_++)
+	{
+		timeout* tout;
+		timeouts_update(tos_, mux_tick_);
+		while (NULL != (tout = timeouts_get(tos_)))
+			tout->callback.action(tout);
+	}
+	ASSERT_EQ(mux_fired_.size(), 3u);
+	EXPECT_EQ(mux_fired_[0].first, &timers[2]);
+	EXPECT_EQ(mux_fired_[1].first, &timers[0]);
+	EXPECT_EQ(mux_fired_[2].first, &timers[1]);
+	for (auto& fired : mux_fired_)
+	{
+		EXPECT_EQ(fired.second, fired.first->deadline);
+		EXPECT_FALSE(mtra_timeout_armed(fired.first));
+	}
+	EXPECT_FALSE(timeouts_pending(tos_));
+
+	// then a timer beyond TIMER_MUX_MAX_TIMERS armed at once gets its own entry
+	for (uint i = 0; i <= TIMER_MUX_MAX_TIMERS; i++)
+		mtra_timeout_start(&timers[i], 100);
+	EXPECT_EQ(mux.num, TIMER_MUX_MAX_TIMERS);
+	EXPECT_NE(timers[TIMER_MUX_MAX_TIMERS].pending, nullptr);
+	mtra_timeouts_stop(&timers[TIMER_MUX_MAX_TIMERS]);
+
+	// then stopping the mux takes all timers and the entry off
+	mtra_timer_mux_stop(&mux);
+	for (uint i = 0; i <= TIMER_MUX_MAX_TIMERS; i++)
+		EXPECT_FALSE(mtra_timeout_armed(&timers[i]));
+	EXPECT_FALSE(timeouts_pending(tos_));
+
+	timeouts_close(tos_);
+	tos_ = saved;
+}
+struct mux_bench_channel_t
+{
+	timer_mux_t mux;
+	timeout timers[4];
+};
+static uint mux_bench_fired_;
+static int mux_bench_cb(timeout* tout)
+{
+	mux_bench_fired_++;
+	return 0;
+}
+TEST(TIMER_MODULE, DISABLED_test_channel_timer_mux_throughput)
+{
+	timeouts* saved = tos_;
+	int err;
+	const uint channels = 100000;
+	// a sack, an init and two heartbeat timers per channel
+	const uint timeout_ms[4] = { 200, 3000, 1000, 1500 };
+	const uint jitter_ms = 1000;
+	std::vector<mux_bench_channel_t> chs(channels);
+
+	for (int muxed = 0; muxed < 2; muxed++)
+	{
+		tos_ = timeouts_open(0, &err);
+		timeout_t now = gettimestamp() / (stamps_per_ms() * WHEEL_TICK_MS);
+		timeouts_update(tos_, now);
+		mux_bench_fired_ = 0;
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (uint n = 0; n < channels; n++)
+		{
+			if (muxed)
+				mtra_timer_mux_init(&chs[n].mux);
+			for (int i = 0; i < 4; i++)
+			{
+				mtra_timeout_init(&chs[n].timers[i], TIMER_TYPE_USER, &mux_bench_cb);
+				if (muxed)
+					mtra_timer_mux_attach(&chs[n].mux, &chs[n].timers[i]);
+				mtra_timeout_start(&chs[n].timers[i], timeout_ms[i] + n % jitter_ms);
+			}
+		}
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+		long long arm_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+		uint entries = 0;
+		for (uint n = 0; n < channels; n++)
+		{
+			if (muxed)
+				entries += chs[n].mux.wheel.pending != NULL;
+			else
+				for (int i = 0; i < 4; i++)
+					entries += chs[n].timers[i].pending != NULL;
+		}
+		EXPECT_EQ(entries, muxed ? channels : 4 * channels);
+
+		// the poller moves the wheel once a tick and fires all timers due
+		timeout* tout;
+		start = std::chrono::steady_clock::now();
+		timeout_t last = now + (3000 + jitter_ms + 100) / WHEEL_TICK_MS;
+		for (timeout_t tick = now + 1; tick <= last; tick++)
+		{
+			timeouts_update(tos_, tick);
+			while (NULL != (tout = timeouts_get(tos_)))
+				tout->callback.action(tout);
+		}
+		end = std::chrono::steady_clock::now();
+		long long expire_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+		EXPECT_EQ(mux_bench_fired_, 4 * channels);
+		EXPECT_FALSE(timeouts_pending(tos_));
+
+		std::cout << (muxed ? "muxed" : "separate") << " timers of " << channels << " channels: " << entries
+			<< " wheel entries, " << (muxed ? sizeof(timer_mux_t) : 0) + 4 * sizeof(timeout)
+			<< " timer bytes per channel, arm " << arm_us << "us, expire " << expire_us << "us.\n";
+		timeouts_close(tos_);
+	}
+	tos_ = saved;
+}
+// last run on 21 Agu 2016 and passed
+TEST(GLOBAL_MODULE, test_saddr_str)
+{
+	sockaddrunion saddr;
+	str2saddr(&saddr, "192.168.1.107", 38000);
+
+	char ret[MAX_IPADDR_STR_LEN];
+	ushort port = 0;
+	saddr2str(&saddr, ret, sizeof(ret), &port);
+	EVENTLOG1(VERBOSE, "saddr {%s}\n", ret);
+	EXPECT_EQ(saddr.sa.sa_family, AF_INET);
+	EXPECT_EQ(strcmp(ret, "192.168.1.107"), 0);
+	EXPECT_EQ(port, 38000);
+
+	sockaddrunion saddr1;
+	str2saddr(&saddr1, "192.168.1.107", 38000);
+	sockaddrunion saddr2;
+	str2saddr(&saddr2, "192.168.1.107", 38000);
+	EXPECT_EQ(saddr_equals(&saddr1, &saddr2), true);
+
+	str2saddr(&saddr1, "192.167.1.125", 38000);
+	str2saddr(&saddr2, "192.168.1.107", 38000);
+	EXPECT_EQ(saddr_equals(&saddr1, &saddr2), false);
+
+	str2saddr(&saddr1, "192.168.1.107", 3800);
+	str2saddr(&saddr2, "192.168.1.107", 38000);
+	EXPECT_EQ(saddr_equals(&saddr1, &saddr2), false);
+
+	str2saddr(&saddr1, "192.168.1.125", 3800);
+	str2saddr(&saddr2, "192.168.1.107", 38000);
+	EXPECT_EQ(saddr_equals(&saddr1, &saddr2), false);
+}
+
+// last run on 27 Agu 2016 and passed
+TEST(MALLOC_MODULE, test_geco_new_delete)
+{
+	int j;
+	int total = 1000000;
+	/*max is 5120 we use 5121 to have the max*/
+	size_t allocsize;
+	size_t dealloc_idx;
+	std::list<alloc_t*> allos;
+	std::list<alloc_t*>::iterator it;
+
+	int alloccnt = 0;
+	int deallcnt = 0;
+	alloc_t* at;
+	for (j = 0; j < total; j++)
+	{
+		if (rand() % 2)
+		{
+
+			uint s = ((rand() * UINT32_MAX) % 1024) + 1;
+			at = geco_new_array<alloc_t>(s, __FILE__, __LINE__);
+			at->allocsize = s;
+			allos.push_back(at);
+			alloccnt += s;
+		}
+		else
+		{
+			size_t s = allos.size();
+			if (s > 0)
+			{
+				dealloc_idx = (rand() % s);
+				it = allos.begin();
+				std::advance(it, dealloc_idx);
+				deallcnt += (*it)->allocsize;
+				geco_delete_array<alloc_t>(*it, __FILE__, __LINE__);
+				allos.erase(it);
+			}
+		}
+	}
+	for (auto& p : allos)
+	{
+		deallcnt += p->allocsize;
+		geco_delete_array<alloc_t>(p, __FILE__, __LINE__);
+	}
+	allos.clear();
+	EXPECT_EQ(alloccnt, deallcnt);
+	EXPECT_EQ(allos.size(), 0);
+}
+TEST(MALLOC_MODULE, test_geco_alloc_dealloc)
+{
+	int j;
+	int total = 1000000;
+	/*max is 5120 we use 5121 to have the max*/
+	size_t allocsize;
+	size_t dealloc_idx;
+	std::list<alloc_t> allos;
+	std::list<alloc_t>::iterator it;
+
+	int alloccnt = 0;
+	int deallcnt = 0;
+	int less_than_max_byte_cnt = 0;
+	int zero_alloc_cnt = 0;
+	alloc_t at;
+	for (j = 0; j < total; j++)
+	{
+		if (rand() % 2)
+		{
+			allocsize = (rand() * UINT32_MAX) % 2049;
+			if (allocsize <= 1512)
+				++less_than_max_byte_cnt;
+			if (allocsize == 0)
+				++zero_alloc_cnt;
+			at.ptr = geco_malloc_ext(allocsize, __FILE__, __LINE__);
+			at.allocsize = allocsize;
+			allos.push_back(at);
+			alloccnt++;
+		}
+		else
+		{
+			size_t s = allos.size();
+			if (s > 0)
+			{
+				dealloc_idx = rand() % s;
+				it = allos.begin();
+				std::advance(it, dealloc_idx);
+				geco_free_ext(it->ptr, __FILE__, __LINE__);
+				allos.erase(it);
+				deallcnt++;
+			}
+		}
+	}
+	for (auto& p : allos)
+	{
+		geco_free_ext(p.ptr, __FILE__, __LINE__);
+		deallcnt++;
+	}
+	allos.clear();
+	EXPECT_EQ(alloccnt, deallcnt);
+	EXPECT_EQ(allos.size(), 0);
+	EVENTLOG5(VERBOSE,
+		"alloccnt %d, dealloccnt %d, < 1512 cnt %d, %d, zer alloc cnt %d\n",
+		alloccnt, deallcnt, less_than_max_byte_cnt,
+		alloccnt - less_than_max_byte_cnt, zero_alloc_cnt);
+}
+static void mt_alloc_free_loop(bool use_geco, int seed, int ops)
+{
+	// a window of live blocks like chunks waiting in send and receive queues
+	void* window[256] = { 0 };
+	uint r = seed;
+	for (int i = 0; i < ops; i++)
+	{
+		r = r * 1103515245 + 12345;
+		int slot = (r >> 8) & 255;
+		size_t size = 1 + (r >> 16) % 1600;
+		if (window[slot] != NULL)
+			use_geco ? geco_free_ext(window[slot], __FILE__, __LINE__) : free(window[slot]);
+		window[slot] = use_geco ? geco_malloc_ext(size, __FILE__, __LINE__) : malloc(size);
+		*(char*)window[slot] = (char)i;
+	}
+	for (int i = 0; i < 256; i++)
+		if (window[i] != NULL)
+			use_geco ? geco_free_ext(window[i], __FILE__, __LINE__) : free(window[i]);
+}
+TEST(MALLOC_MODULE, DISABLED_test_geco_alloc_mt_benchmark)
+{
+	const int ops = 1000000;
+	for (int threads = 1; threads <= 4; threads <<= 1)
+	{
+		for (int use_geco = 0; use_geco < 2; use_geco++)
+		{
+			std::vector<std::thread> workers;
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			for (int t = 0; t < threads; t++)
+				workers.push_back(std::thread(mt_alloc_free_loop, use_geco != 0, t + 1, ops));
+			for (auto& w : workers)
+				w.join();
+			std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+			std::cout << (use_geco ? "geco_malloc_ext " : "malloc ") << threads << " threads x " << ops
+				<< " alloc/free took "
+				<< std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << "us.\n";
+		}
+	}
+}
+TEST(MALLOC_MODULE, test_geco_alloc_cross_thread_free)
+{
+	// blocks allocated by one thread and freed by another
+	std::vector<void*> blocks;
+	std::thread producer([&blocks]()
+	{
+		for (int i = 0; i < 10000; i++)
+		{
+			void* p = geco_malloc_ext(i % 2048, __FILE__, __LINE__);
+			EXPECT_EQ((size_t)p & 15, 0u);
+			blocks.push_back(p);
+		}
+	});
+	producer.join();
+	geco_malloc_stats_t before;
+	geco_malloc_get_stats(&before);
+	std::thread consumer([&blocks]()
+	{
+		for (auto p : blocks)
+			geco_free_ext(p, __FILE__, __LINE__);
+	});
+	consumer.join();
+	geco_malloc_stats_t after;
+	geco_malloc_get_stats(&after);
+	// the consumer kept at most two batches per class and handed the rest back
+	EXPECT_GT(after.depot_flushes, before.depot_flushes);
+
+	// big blocks bypass the size classes
+	void* big = geco_malloc_ext(64 * 1024, __FILE__, __LINE__);
+	geco_malloc_get_stats(&after);
+	EXPECT_GE(after.large_bytes, (size_t)64 * 1024);
+	big = geco_realloc_ext(big, 100, __FILE__, __LINE__);
+	geco_free_ext(big, __FILE__, __LINE__);
+
+	// zero byte blocks have room for a byte, growing to it stays in place
+	void* empty = geco_malloc_ext(0, __FILE__, __LINE__);
+	EXPECT_EQ(geco_realloc_ext(empty, 1, __FILE__, __LINE__), empty);
+	*(char*)empty = 1;
+	geco_free_ext(empty, __FILE__, __LINE__);
+}
+TEST(MALLOC_MODULE, test_object_pool_watermarks)
+{
+	object_pool_t<timeout> pool(2, 4);
+	pool.reserve(3, __FILE__, __LINE__);
+	EXPECT_EQ(pool.free_num(), 3u);
+
+	// allocs take the pooled objects first without touching geco_malloc_ext
+	size_t allocs = geco_malloc_thread_alloc_count();
+	timeout* touts[6];
+	for (int i = 0; i < 3; i++)
+		touts[i] = pool.alloc(__FILE__, __LINE__);
+	EXPECT_EQ(geco_malloc_thread_alloc_count(), allocs);
+	EXPECT_EQ(pool.free_num(), 0u);
+	for (int i = 3; i < 6; i++)
+		touts[i] = pool.alloc(__FILE__, __LINE__);
+	EXPECT_EQ(geco_malloc_thread_alloc_count(), allocs + 3);
+
+	// up to the high watermark objects stay pooled, the fifth free trims down to the low one
+	for (int i = 0; i < 4; i++)
+		pool.free(touts[i], __FILE__, __LINE__);
+	EXPECT_EQ(pool.free_num(), 4u);
+	pool.free(touts[4], __FILE__, __LINE__);
+	EXPECT_EQ(pool.free_num(), 2u);
+	// pooled objects are geco_malloc_ext blocks
+	geco_free_ext(touts[5], __FILE__, __LINE__);
+}
+TEST(MALLOC_MODULE, test_huge_page_spans)
+{
+	geco_malloc_stats_t before, after;
+	std::vector<void*> blocks;
+
+	// every span comes from an arena or malloc() counted by page kind
+	geco_malloc_get_stats(&before);
+	for (int i = 0; i < 1024; i++)
+		blocks.push_back(geco_malloc_ext(3000, __FILE__, __LINE__));
+	geco_malloc_get_stats(&after);
+	EXPECT_GE(after.hugetlb_bytes + after.thp_bytes + after.normal_page_bytes, after.span_bytes);
+	std::cout << "span bytes " << after.span_bytes << ", hugetlb bytes " << after.hugetlb_bytes << ", thp bytes "
+		<< after.thp_bytes << ", normal page bytes " << after.normal_page_bytes << std::endl;
+
+	// with huge pages off new spans come from malloc()
+	geco_malloc_use_huge_pages(false);
+	geco_malloc_get_stats(&before);
+	for (int i = 0; i < 1024; i++)
+		blocks.push_back(geco_malloc_ext(7000, __FILE__, __LINE__));
+	geco_malloc_get_stats(&after);
+	geco_malloc_use_huge_pages(true);
+	EXPECT_EQ(after.normal_page_bytes - before.normal_page_bytes, after.span_bytes - before.span_bytes);
+	EXPECT_EQ(after.hugetlb_bytes, before.hugetlb_bytes);
+	EXPECT_EQ(after.thp_bytes, before.thp_bytes);
+
+	for (void* block : blocks)
+		geco_free_ext(block, __FILE__, __LINE__);
+}
+static const geco_heap_site_t* find_heap_site(const geco_heap_site_t* sites, size_t n, unsigned int line)
+{
+	for (size_t i = 0; i < n; i++)
+		if (sites[i].line == line && strcmp(sites[i].file, __FILE__) == 0)
+			return sites + i;
+	return NULL;
+}
+TEST(MALLOC_MODULE, test_heap_profiler)
+{
+	geco_heap_site_t sites[256];
+	void* blocks[8];
+	geco_heap_profiler_enable(true);
+	const unsigned int small_line = __LINE__ + 2;
+	for (int i = 0; i < 6; i++)
+		blocks[i] = geco_malloc_ext(100, __FILE__, __LINE__);
+	const unsigned int large_line = __LINE__ + 1;
+	blocks[6] = geco_malloc_ext(10000, __FILE__, __LINE__);
+	size_t n = geco_heap_profiler_snapshot(sites, 256);
+	const geco_heap_site_t* small_site = find_heap_site(sites, n, small_line);
+	const geco_heap_site_t* large_site = find_heap_site(sites, n, large_line);
+	ASSERT_TRUE(small_site != NULL);
+	ASSERT_TRUE(large_site != NULL);
+	size_t small_allocs = small_site->allocs;
+	EXPECT_EQ(small_site->live_blocks, 6u);
+	EXPECT_EQ(small_site->live_bytes, 600u);
+	EXPECT_EQ(large_site->live_bytes, 10000u);
+	// sites come ordered by live bytes
+	EXPECT_TRUE(large_site < small_site);
+
+	// a block stays charged to the site that allocated it, whoever frees it
+	for (int i = 0; i < 4; i++)
+		geco_free_ext(blocks[i], __FILE__, __LINE__);
+	geco_free_ext(blocks[6], __FILE__, __LINE__);
+	n = geco_heap_profiler_snapshot(sites, 256);
+	small_site = find_heap_site(sites, n, small_line);
+	ASSERT_TRUE(small_site != NULL);
+	EXPECT_EQ(small_site->live_blocks, 2u);
+	EXPECT_EQ(small_site->live_bytes, 200u);
+	EXPECT_EQ(small_site->peak_bytes, 600u);
+	EXPECT_EQ(small_site->allocs, small_allocs);
+	geco_heap_profiler_dump(stdout);
+
+	// blocks allocated while it is off are not profiled
+	geco_heap_profiler_enable(false);
+	blocks[7] = geco_malloc_ext(100, __FILE__, __LINE__);
+	geco_free_ext(blocks[4], __FILE__, __LINE__);
+	geco_free_ext(blocks[5], __FILE__, __LINE__);
+	geco_free_ext(blocks[7], __FILE__, __LINE__);
+	n = geco_heap_profiler_snapshot(sites, 256);
+	small_site = find_heap_site(sites, n, small_line);
+	ASSERT_TRUE(small_site != NULL);
+	EXPECT_EQ(small_site->live_bytes, 0u);
+	EXPECT_EQ(small_site->allocs, small_allocs);
+}
+// last run on 21 Agu 2016 and passed
+TEST(MALLOC_MODULE, test_alloc_dealloc)
+{
+	single_client_alloc allocator;
+	int j;
+	int total = 1000000;
+	/*max is 5120 we use 5121 to have the max*/
+	size_t allocsize;
+	size_t dealloc_idx;
+	std::list<alloc_t> allos;
+	std::list<alloc_t>::iterator it;
+
+	int alloccnt = 0;
+	int deallcnt = 0;
+	int less_than_max_byte_cnt = 0;
+	int zero_alloc_cnt = 0;
+	alloc_t at;
+	for (j = 0; j < total; j++)
+	{
+		if (rand() % 2)
+		{
+			allocsize = (rand() * UINT32_MAX) % 2049;
+			if (allocsize <= 1512)
+				++less_than_max_byte_cnt;
+			if (allocsize == 0)
+				++zero_alloc_cnt;
+			at.ptr = allocator.allocate(allocsize);
+			at.allocsize = allocsize;
+			allos.push_back(at);
+			alloccnt++;
+		}
+		else
+		{
+			size_t s = allos.size();
+			if (s > 0)
+			{
+				dealloc_idx = rand() % s;
+				it = allos.begin();
+				std::advance(it, dealloc_idx);
+				allocator.deallocate(it->ptr, it->allocsize);
+				allos.erase(it);
+				deallcnt++;
+			}
+		}
+	}
+	for (auto& p : allos)
+	{
+		allocator.deallocate(p.ptr, p.allocsize);
+		deallcnt++;
+	}
+	allos.clear();
+	allocator.destroy();
+	EXPECT_EQ(alloccnt, deallcnt);
+	EXPECT_EQ(allos.size(), 0);
+	EVENTLOG5(VERBOSE,
+		"alloccnt %d, dealloccnt %d, < 1512 cnt %d, %d, zer alloc cnt %d\n",
+		alloccnt, deallcnt, less_than_max_byte_cnt,
+		alloccnt - less_than_max_byte_cnt, zero_alloc_cnt);
+}
+
+// last pass on 26 Oct 2016
+TEST(AUTH_MODULE, test_md5)
+{
+	unsigned char digest[HMAC_LEN];
+	MD5_CTX ctx;
+
+	const char* testdata = "202cb962ac59075b964b07152d234b70";
+	const char* result = "d9b1d7db4cd6e70935368a1efb10e377";
+	MD5Init(&ctx);
+	MD5Update(&ctx, (uchar*)testdata, strlen(testdata));
+	MD5Final(digest, &ctx);
+	EVENTLOG1(VERBOSE, "Computed MD5 signature : %s",
+		hexdigest(digest, HMAC_LEN));
+	EXPECT_STREQ(hexdigest(digest, 16), result);
+
+	testdata = "d9b1d7db4cd6e70935368a1efb10e377";
+	result = "7363a0d0604902af7b70b271a0b96480";
+	MD5Init(&ctx);
+	MD5Update(&ctx, (uchar*)testdata, strlen(testdata));
+	MD5Final(digest, &ctx);
+	EVENTLOG1(VERBOSE, "Computed MD5 signature : %s",
+		hexdigest(digest, HMAC_LEN));
+	EXPECT_STREQ(hexdigest(digest, 16), result);
+}
+TEST(AUTH_MODULE, test_sockaddr2hashcode)
+{
+	uint ret;
+	sockaddrunion localsu;
+	str2saddr(&localsu, "192.168.1.107", 36000);
+	sockaddrunion peersu;
+	str2saddr(&peersu, "192.168.1.107", 36000);
+	ret = transportaddr2hashcode(&localsu, &peersu);
+	EVENTLOG2(
+		VERBOSE,
+		"hash(addr pair { localsu: 192.168.1.107:36001 peersu: 192.168.1.107:36000 }) = %u, %u",
+		ret, ret % 100000);
+
+	str2saddr(&localsu, "192.168.1.107", 1234);
+	str2saddr(&peersu, "192.168.1.107", 360);
+	ret = transportaddr2hashcode(&localsu, &peersu);
+	EVENTLOG2(
+		VERBOSE,
+		"hash(addr pair { localsu: 192.168.1.107:36001 peersu: 192.168.1.107:36000 }) = %u, %u",
+		ret, ret % 100000);
+}
+TEST(AUTH_MODULE, test_crc32_checksum)
+{
+	for (int ii = 0; ii < 100; ii++)
+	{
+		geco_packet_t geco_packet;
+		geco_packet.pk_comm_hdr.checksum = 0;
+		geco_packet.pk_comm_hdr.dest_port = htons(
+			(generate_random_uint32() % USHRT_MAX));
+		geco_packet.pk_comm_hdr.src_port = htons(
+			(generate_random_uint32() % USHRT_MAX));
+		geco_packet.pk_comm_hdr.verification_tag = htons(
+			(generate_random_uint32()));
+		((chunk_fixed_t*)geco_packet.chunk)->chunk_id = CHUNK_DATA;
+		((chunk_fixed_t*)geco_packet.chunk)->chunk_length = htons(100);
+		((chunk_fixed_t*)geco_packet.chunk)->chunk_flags =
+			DCHUNK_FLAG_UNORDER | DCHUNK_FLAG_FL_FRG;
+		for (int i = 0; i < 100; i++)
+		{
+			uchar* wt = geco_packet.chunk + CHUNK_FIXED_SIZE;
+			wt[i] = generate_random_uint32() % UCHAR_MAX;
+		}
+		set_crc32_checksum((char*)&geco_packet, DCHUNK_R_O_S_FIXED_SIZES + 100);
+		bool ret = validate_crc32_checksum((char*)&geco_packet,
+			DCHUNK_R_O_S_FIXED_SIZES + 100);
+		EXPECT_TRUE(ret);
+	}
+}
+TEST(AUTH_MODULE, test_crc32_fused_copy_and_combine)
+{
+	char chunks[GECO_PACKET_FIXED_SIZE + 1024];
+	for (int ii = 0; ii < 100; ii++)
+	{
+		int chunks_len = 4 + generate_random_uint32() % 1000;
+		int split = generate_random_uint32() % chunks_len;
+		for (int i = 0; i < chunks_len; i++)
+			chunks[i] = generate_random_uint32() % UCHAR_MAX;
+
+		// copy the chunks in two runs as the bundler does, then combine
+		geco_packet_t geco_packet;
+		geco_packet.pk_comm_hdr.dest_port = htons(1234);
+		geco_packet.pk_comm_hdr.src_port = htons(5678);
+		geco_packet.pk_comm_hdr.verification_tag = htonl(generate_random_uint32());
+		uint crc1 = crc32c_copy(geco_packet.chunk, chunks, split, 0);
+		uint crc2 = crc32c_copy(geco_packet.chunk + split, chunks + split, chunks_len - split, 0);
+		EXPECT_EQ(memcmp(geco_packet.chunk, chunks, chunks_len), 0);
+		EXPECT_EQ(crc32c_combine(crc1, crc2, chunks_len - split), crc32c_update(0, chunks, chunks_len));
+
+		set_crc32_checksum_fused((char*)&geco_packet, GECO_PACKET_FIXED_SIZE,
+			crc32c_combine(crc1, crc2, chunks_len - split), chunks_len);
+		uint fused = geco_packet.pk_comm_hdr.checksum;
+		set_crc32_checksum((char*)&geco_packet, GECO_PACKET_FIXED_SIZE + chunks_len);
+		EXPECT_EQ(fused, geco_packet.pk_comm_hdr.checksum);
+	}
+}
+TEST(AUTH_MODULE, DISABLED_test_crc32c_combine_benchmark)
+{
+	// a full packet of a sack, some ctrl chunks and data chunks, checksummed by
+	// recomputing the crc over it against combining the crcs kept per region
+	const int rounds = 200000;
+	const uint regions[3] = { 20, 100, 1268 };
+	char packet[GECO_PACKET_FIXED_SIZE + 1388];
+	for (uint i = 0; i < sizeof(packet); i++)
+		packet[i] = generate_random_uint32() % UCHAR_MAX;
+	uint region_crcs[3];
+	uint pos = GECO_PACKET_FIXED_SIZE;
+	for (int r = 0; r < 3; r++)
+	{
+		region_crcs[r] = crc32c_update(0, packet + pos, regions[r]);
+		pos += regions[r];
+	}
+
+	volatile uint sink = 0;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int i = 0; i < rounds; i++)
+		sink = crc32c_update(0, packet, sizeof(packet));
+	std::chrono::steady_clock::time_point mid = std::chrono::steady_clock::now();
+	for (int i = 0; i < rounds; i++)
+	{
+		uint crc = crc32c_update(0, packet, GECO_PACKET_FIXED_SIZE);
+		for (int r = 0; r < 3; r++)
+			crc = crc32c_combine(crc, region_crcs[r], regions[r]);
+		sink = crc;
+	}
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+	EXPECT_EQ(sink, crc32c_update(0, packet, sizeof(packet)));
+
+	long long update_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(mid - start).count() / rounds;
+	long long combine_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - mid).count() / rounds;
+	std::cout << sizeof(packet) << " bytes packet: crc32c_update " << update_ns << "ns, header + 3 crc32c_combine "
+		<< combine_ns << "ns\n";
+	EXPECT_LT(combine_ns, update_ns);
+}
+TEST(AUTH_MODULE, test_siphash_cookie_signature)
+{
+	// reference vectors from the SipHash-2-4-128 paper
+	uchar key[16], msg[16], mac[16];
+	for (int i = 0; i < 16; i++)
+		key[i] = msg[i] = i;
+	siphash24_128(key, msg, 0, mac);
+	EXPECT_STREQ(hexdigest(mac, 16), "a3817f04ba25a8e66df67214c7550293");
+	siphash24_128(key, msg, 15, mac);
+	EXPECT_STREQ(hexdigest(mac, 16), "5493e99933b0a8117e08ec0f97cfc3d9");
+
+	uchar cookie[COOKIE_FIXED_SIZE + 64];
+	for (uint i = 0; i < sizeof(cookie); i++)
+		cookie[i] = generate_random_uint32() % UCHAR_MAX;
+	sign_cookie(cookie, sizeof(cookie), mac);
+	EXPECT_TRUE(verify_cookie(cookie, sizeof(cookie), mac));
+	cookie[7] ^= 1;
+	EXPECT_FALSE(verify_cookie(cookie, sizeof(cookie), mac));
+	cookie[7] ^= 1;
+
+	// still valid within the grace window of the previous secret
+	rotate_cookie_secret();
+	EXPECT_TRUE(verify_cookie(cookie, sizeof(cookie), mac));
+	rotate_cookie_secret();
+	EXPECT_FALSE(verify_cookie(cookie, sizeof(cookie), mac));
+}
+TEST(AUTH_MODULE, test_heartbeat_key_per_thread)
+{
+	// initialized once per thread and kept, other threads neither share nor race on it
+	uchar* key = get_secre_key(KEY_READ);
+	uchar copy[SECRET_KEYSIZE];
+	memcpy(copy, key, SECRET_KEYSIZE);
+	ASSERT_EQ(get_secre_key(KEY_READ), key);
+	uchar* other = NULL;
+	std::thread t([&other]()
+	{
+		other = get_secre_key(KEY_READ);
+	});
+	t.join();
+	ASSERT_NE(other, key);
+	ASSERT_EQ(memcmp(get_secre_key(KEY_READ), copy, SECRET_KEYSIZE), 0);
+}
+TEST(AUTH_MODULE, DISABLED_test_cookie_signature_throughput)
+{
+	// one handshake costs a cookie signing (INIT) and a verification (COOKIE-ECHO)
+	const int handshakes = 100000;
+	uchar cookie[COOKIE_FIXED_SIZE + 64];
+	uchar mac[HMAC_LEN];
+	uchar* key = get_secre_key(KEY_READ);
+	for (uint i = 0; i < sizeof(cookie); i++)
+		cookie[i] = generate_random_uint32() % UCHAR_MAX;
+
+	MD5_CTX ctx;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int i = 0; i < handshakes * 2; i++)
+	{
+		MD5Init(&ctx);
+		MD5Update(&ctx, cookie, sizeof(cookie));
+		MD5Update(&ctx, key, SECRET_KEYSIZE);
+		MD5Final(mac, &ctx);
+	}
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+	std::cout << "md5(cookie|key) " << handshakes << " handshakes took "
+		<< std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << "us.\n";
+
+	int verified = 0;
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < handshakes; i++)
+	{
+		cookie[0] = (uchar)i;
+		sign_cookie(cookie, sizeof(cookie), mac);
+		verified += verify_cookie(cookie, sizeof(cookie), mac);
+	}
+	end = std::chrono::steady_clock::now();
+	std::cout << "siphash cookie " << handshakes << " handshakes took "
+		<< std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << "us.\n";
+	EXPECT_EQ(verified, handshakes);
+
+	uint sum = 0;
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < handshakes; i++)
+		sum += generate_random_uint32();
+	end = std::chrono::steady_clock::now();
+	std::cout << "generate_random_uint32 " << handshakes << " times took "
+		<< std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << "us (" << sum
+		<< ").\n";
+}
+
+TEST(BITSTREAM_MODULE, test_word_bit_io_round_trip)
+{
+	// every width at every bit offset crosses the 64 bits word boundaries differently
+	uchar src[32], dest[32];
+	for (uint i = 0; i < sizeof(src); i++)
+		src[i] = generate_random_uint32() % UCHAR_MAX;
+	for (int offset = 0; offset < 8; offset++)
+	{
+		for (int bits = 1; bits <= 200; bits++)
+		{
+			geco_bit_stream_t stream;
+			for (int i = 0; i < offset; i++)
+				stream.Write(true);
+			stream.WriteBits(src, bits);
+			stream.Write(true);
+			bool b;
+			for (int i = 0; i < offset; i++)
+				stream.Read(b);
+			memset(dest, 0, sizeof(dest));
+			stream.ReadBits(dest, bits);
+			EXPECT_EQ(memcmp(src, dest, bits >> 3), 0);
+			if (bits & 7)
+			{
+				EXPECT_EQ(dest[bits >> 3], src[bits >> 3] & ((1 << (bits & 7)) - 1));
+			}
+			stream.Read(b);
+			EXPECT_TRUE(b);
+		}
+	}
+
+	// the upper half of the last byte is only dropped when the reader can restore it
+	geco_bit_stream_t stream;
+	uint values[] = { 0, 5, 0xf5, 0x0105, 0x1234, 0xfff5, 0x12345678, 0xffffffff };
+	for (uint i = 0; i < sizeof(values) / sizeof(uint); i++)
+	{
+		stream.WriteMini(values[i]);
+		stream.WriteMini((uchar*)&values[i], 32, false);
+		stream.Write(false);
+	}
+	for (uint i = 0; i < sizeof(values) / sizeof(uint); i++)
+	{
+		uint value = 0;
+		stream.ReadMini(value);
+		EXPECT_EQ(value, values[i]);
+		stream.ReadMini((uchar*)&value, 32, false);
+		EXPECT_EQ(value, values[i]);
+		bool b;
+		stream.Read(b);
+		EXPECT_FALSE(b);
+	}
+}
+TEST(BITSTREAM_MODULE, test_bit_io_throughput)
+{
+	// a movement update: flags, a 3 bits state, 10 bits quantized yaw, 20 bits position
+	// fields, mini coded entity id and sequence number, 9 fields each
+	const int updates = 200000;
+	const int fields = updates * 9;
+	geco_bit_stream_t stream(updates * 16);
+	uint yaw, x, y;
+	ushort seq;
+	uint id;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int i = 0; i < updates; i++)
+	{
+		yaw = i & 1023, x = i * 7 & 0xfffff, y = i * 13 & 0xfffff;
+		seq = (ushort)i;
+		id = i & 4095;
+		stream.Write((i & 1) != 0);
+		stream.Write((i & 2) != 0);
+		stream.WriteBits((uchar*)&i, 3);
+		stream.WriteBits((uchar*)&yaw, 10);
+		stream.WriteBits((uchar*)&x, 20);
+		stream.WriteBits((uchar*)&y, 20);
+		stream.WriteMini(id);
+		stream.WriteMini(seq);
+		stream.Write(true);
+	}
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+	long long us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	std::cout << "write " << fields << " fields (" << stream.get_written_bytes() << " bytes) took " << us
+		<< "us, " << (long long)fields * 1000000 / (us + 1) << " fields/sec.\n";
+
+	int errors = 0;
+	bool b;
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < updates; i++)
+	{
+		uint state = 0;
+		yaw = x = y = id = 0;
+		stream.Read(b);
+		stream.Read(b);
+		stream.ReadBits((uchar*)&state, 3);
+		stream.ReadBits((uchar*)&yaw, 10);
+		stream.ReadBits((uchar*)&x, 20);
+		stream.ReadBits((uchar*)&y, 20);
+		stream.ReadMini(id);
+		stream.ReadMini(seq);
+		stream.Read(b);
+		errors += state != (uint)(i & 7) || yaw != (uint)(i & 1023) || x != (uint)(i * 7 & 0xfffff)
+			|| id != (uint)(i & 4095) || seq != (ushort)i || !b;
+	}
+	end = std::chrono::steady_clock::now();
+	us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	std::cout << "read " << fields << " fields took " << us << "us, "
+		<< (long long)fields * 1000000 / (us + 1) << " fields/sec.\n";
+	EXPECT_EQ(errors, 0);
+}
+TEST(BITSTREAM_MODULE, test_huffman_table_decoding)
+{
+	// every character, including the rare ones resolved by the second level tables
+	HuffmanEncodingTree tree;
+	tree.GenerateFromFrequencyTable();
+	uchar input[512], output[512];
+	for (int i = 0; i < 512; i++)
+		input[i] = (uchar)(i * 7);
+	for (int offset = 0; offset < 8; offset++)
+	{
+		geco_bit_stream_t stream;
+		for (int i = 0; i < offset; i++)
+			stream.Write(false);
+		tree.EncodeArray(input, sizeof(input), &stream);
+		bool b;
+		for (int i = 0; i < offset; i++)
+			stream.Read(b);
+		bit_size_t bits = stream.get_payloads();
+		EXPECT_EQ(tree.DecodeArray(&stream, bits, sizeof(output), output), sizeof(input));
+		EXPECT_EQ(memcmp(input, output, sizeof(input)), 0);
+		EXPECT_EQ(stream.get_payloads(), 0);
+	}
+
+	geco_bit_stream_t encoded, decoded;
+	tree.EncodeArray(input, sizeof(input), &encoded);
+	tree.DecodeArray(encoded.uchar_data(), encoded.get_written_bits(), &decoded);
+	EXPECT_EQ(decoded.get_written_bytes(), sizeof(input));
+	EXPECT_EQ(memcmp(input, decoded.uchar_data(), sizeof(input)), 0);
+}
+TEST(BITSTREAM_MODULE, test_string_compressor_throughput)
+{
+	const int messages = 100000;
+	const char* chat = "gg wp, meet at the bridge in 30 seconds and bring the healer!";
+	const int length = (int)strlen(chat);
+	char output[128];
+	geco_string_compressor_t* compressor = geco_string_compressor_t::Instance();
+	geco_bit_stream_t stream(messages * 64);
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int i = 0; i < messages; i++)
+		compressor->EncodeString(chat, sizeof(output), &stream);
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+	long long us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	std::cout << "encode " << messages << " strings (" << messages * length << " to "
+		<< stream.get_written_bytes() << " bytes) took " << us << "us, "
+		<< (double)messages * length / (us + 1) << " MB/s.\n";
+
+	int errors = 0;
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < messages; i++)
+	{
+		compressor->DecodeString(output, sizeof(output), &stream);
+		errors += strcmp(output, chat) != 0;
+	}
+	end = std::chrono::steady_clock::now();
+	us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	std::cout << "decode " << messages << " strings took " << us << "us, "
+		<< (double)messages * length / (us + 1) << " MB/s.\n";
+	EXPECT_EQ(errors, 0);
+}
+
+/// game messages of an ordered stream: entity updates that mostly repeat the previous ones
+static uint make_lz_test_msg(uint n, uchar* msg)
+{
+	uint len = n % 64 == 0 ? 1400 : 40 + n % 60;
+	for (uint j = 0; j < len; j++)
+		msg[j] = (uchar)("{id:1042,pos:[12.5,3.0,-7.25],hp:100,anim:run}"[(j + n % 5) % 46] + (j % 11 == 0 ? n % 7 : 0));
+	return len;
+}
+TEST(LZ_MODULE, test_lz_window_round_trip)
+{
+	lz_encoder_t* enc = new lz_encoder_t;
+	lz_window_t* window = new lz_window_t;
+	lz_encoder_init(enc);
+	lz_window_init(window);
+	std::vector<uchar> msg(3 * LZ_WINDOW_SIZE), out(LZ_MAX_COMPRESSED_SIZE(msg.size())), decoded(msg.size());
+	for (uint n = 0; n < 2000; n++)
+	{
+		// messages longer than the window, random ones and raw ones keep both windows in step
+		uint len = n % 97 == 0 ? (uint)msg.size() - n : make_lz_test_msg(n, &msg[0]);
+		if (n % 97 == 0 || n % 13 == 0)
+		{
+			for (uint j = 0; j < len; j++)
+				msg[j] = (uchar)generate_random_uint32();
+		}
+		if (n % 10 == 0)
+		{
+			lz_encoder_append(enc, &msg[0], len);
+			lz_window_append(window, &msg[0], len);
+			continue;
+		}
+		lz_encoder_t* dict = n % 7 == 0 ? NULL : enc;
+		uint size = lz_compress(dict, &msg[0], len, &out[0], (uint)out.size());
+		ASSERT_GT(size, 0);
+		ASSERT_EQ(lz_decompress(dict == NULL ? NULL : window, &out[0], size, &decoded[0], len), len);
+		ASSERT_EQ(memcmp(&decoded[0], &msg[0], len), 0);
+	}
+
+	// too small an output fails, malformed input is rejected without touching the window
+	uint len = make_lz_test_msg(1, &msg[0]);
+	EXPECT_EQ(lz_compress(NULL, &msg[0], len, &out[0], 4), 0);
+	uint window_len = window->len;
+	uchar far_match[] = { 0x3f, 0xff };
+	EXPECT_EQ(lz_decompress(NULL, far_match, sizeof(far_match), &decoded[0], 100), 0);
+	uchar short_literals[] = { 10, 'a', 'b' };
+	EXPECT_EQ(lz_decompress(window, short_literals, sizeof(short_literals), &decoded[0], 100), 0);
+	EXPECT_EQ(window->len, window_len);
+	delete enc;
+	delete window;
+}
+TEST(LZ_MODULE, test_lz_stage_throughput)
+{
+	const uint messages = 100000;
+	std::vector<uchar> msgs(messages * 100);
+	std::vector<uint> lens(messages);
+	uint total = 0;
+	uchar big[1400];
+	for (uint n = 0; n < messages; n++)
+	{
+		lens[n] = make_lz_test_msg(n % 64 == 0 ? n + 1 : n, big);
+		memcpy(&msgs[total], big, lens[n]);
+		total += lens[n];
+	}
+	std::vector<uchar> out(LZ_MAX_COMPRESSED_SIZE(1400)), sent(total);
+
+	// raw send copies every message into its chunks
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (uint n = 0, pos = 0; n < messages; pos += lens[n++])
+		memcpy(&sent[pos], &msgs[pos], lens[n]);
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+	long long us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	std::cout << "raw " << messages << " messages (" << total << " bytes) took " << us << "us, "
+		<< (double)total / (us + 1) << " MB/s.\n";
+
+	lz_encoder_t* enc = new lz_encoder_t;
+	lz_window_t* window = new lz_window_t;
+	for (int dictionary = 0; dictionary < 2; dictionary++)
+	{
+		lz_encoder_init(enc);
+		lz_window_init(window);
+		std::vector<uint> sizes(messages);
+		uint compressed = 0;
+		start = std::chrono::steady_clock::now();
+		for (uint n = 0, pos = 0; n < messages; pos += lens[n++])
+		{
+			sizes[n] = lz_compress(dictionary ? enc : NULL, &msgs[pos], lens[n], &out[0], (uint)out.size());
+			memcpy(&sent[compressed], &out[0], sizes[n]);
+			compressed += sizes[n];
+		}
+		end = std::chrono::steady_clock::now();
+		us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+		std::cout << (dictionary ? "with" : "without") << " dictionary compress " << total << " to " << compressed
+			<< " bytes (" << (double)compressed * 100 / total << "%) took " << us << "us, "
+			<< (double)total / (us + 1) << " MB/s.\n";
+
+		int errors = 0;
+		start = std::chrono::steady_clock::now();
+		for (uint n = 0, pos = 0, in = 0; n < messages; pos += lens[n], in += sizes[n++])
+		{
+			uint len = lz_decompress(dictionary ? window : NULL, &sent[in], sizes[n], big, lens[n]);
+			errors += len != lens[n] || memcmp(big, &msgs[pos], len) != 0;
+		}
+		end = std::chrono::steady_clock::now();
+		us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+		std::cout << (dictionary ? "with" : "without") << " dictionary decompress took " << us << "us, "
+			<< (double)total / (us + 1) << " MB/s.\n";
+		EXPECT_EQ(errors, 0);
+	}
+	delete enc;
+	delete window;
+}
+
+static bool flag = true;
+static char inputs[1024];
+static int len;
+static void
+stdin_cb(char* data, size_t datalen)
+{
+	EVENTLOG2(DEBUG, "stdin_cb()::%d bytes : %s", datalen, inputs);
+
+	memcpy(inputs, data, datalen);
+	if (strcmp(data, "q") == 0)
+	{
+		flag = false;
+		return;
+	}
+
+	int sentsize;
+	uchar tos = IPTOS_DEFAULT;
+	sockaddrunion saddr;
+
+	str2saddr(&saddr, "::1", USED_UDP_PORT);
+	sentsize = mtra_send_rawsock_ip6(mtra_read_ip6rawsock(), inputs, datalen,
+		&saddr, tos);
+	assert(sentsize == datalen);
+	EXPECT_STRCASEEQ(data, inputs);
+
+	str2saddr(&saddr, "127.0.0.1", USED_UDP_PORT);
+	sentsize = mtra_send_rawsock_ip4(mtra_read_ip4rawsock(), inputs, datalen,
+		&saddr, tos);
+	assert(sentsize == datalen);
+	EXPECT_STRCASEEQ(data, inputs);
+
+	str2saddr(&saddr, "::1", USED_UDP_PORT);
+	sentsize = mtra_send_udpsock_ip6(mtra_read_ip6udpsock(), inputs, datalen,
+		&saddr, tos);
+	assert(sentsize == datalen);
+	EXPECT_STRCASEEQ(data, inputs);
+
+	str2saddr(&saddr, "127.0.0.1", USED_UDP_PORT);
+	sentsize = mtra_send_udpsock_ip4(mtra_read_ip4udpsock(), inputs, datalen,
+		&saddr, tos);
+	assert(sentsize == datalen);
+	EXPECT_STRCASEEQ(data, inputs);
+}
+static void
+socket_cb(int sfd, char* data, int datalen, sockaddrunion* from,
+	sockaddrunion* to)
+{
+	EXPECT_STRCASEEQ(data, inputs);
+
+	static char fromstr[MAX_IPADDR_STR_LEN];
+	static char tostr[MAX_IPADDR_STR_LEN];
+	ushort fport;
+	ushort tport;
+	saddr2str(from, fromstr, MAX_IPADDR_STR_LEN, &fport);
+	saddr2str(to, tostr, MAX_IPADDR_STR_LEN, &tport);
+
+	if (sfd == mtra_read_ip4rawsock())
+	{
+		EVENTLOG8(
+			DEBUG,
+			"socket_cb(ip%d raw fd=%d)::receive (%d) bytes  of data(%s) from addr (%s:%d) to addr (%s:%d)",
+			4, sfd, datalen, data, fromstr, fport, tostr, tport);
+	}
+	else if (sfd == mtra_read_ip6rawsock())
+	{
+		EVENTLOG8(
+			DEBUG,
+			"socket_cb(ip%d raw fd=%d)::receive (%d) bytes  of data(%s) from addr (%s:%d) to addr (%s:%d)",
+			6, sfd, datalen, data, fromstr, fport, tostr, tport);
+	}
+	else if (sfd == mtra_read_ip6udpsock())
+	{
+		EVENTLOG8(
+			DEBUG,
+			"socket_cb(ip%d udp fd=%d)::receive (%d) bytes  of data(%s) from addr (%s:%d) to addr (%s:%d)",
+			6, sfd, datalen, data, fromstr, fport, tostr, tport);
+	}
+	else if (sfd == mtra_read_ip4udpsock())
+	{
+		EVENTLOG8(
+			DEBUG,
+			"socket_cb(ip%d udp fd=%d)::receive (%d) bytes  of data(%s) from addr (%s:%d) to addr (%s:%d)",
+			4, sfd, datalen, data, fromstr, fport, tostr, tport);
+	}
+	else
+	{
+		EVENTLOG(DEBUG, "NO SUCH SFD");
+	}
+}
+
+static int
+wheel_timer_cb(timeout* id)
+{
+	EVENTLOG(DEBUG, "wheel timer timeouts, BYE!");
+	//flag = false;
+	return true;
+}
+
+static void
+task_cb(void* userdata)
+{
+	static int counter = 0;
+	counter++;
+	if (counter > 300)
+	{
+		EVENTLOG1(DEBUG,
+			"task_cb called 300 times with tick of 10ms(userdata = %s)",
+			(char*)userdata);
+		counter = 0;
+	}
+}
+
+int
+socket_read_start(void* user_data)
+{
+	printf("socket read starts\n");
+	return 0;
+}
+int
+socket_read_end(int sfd, bool isudpsocket, char* data, int datalen,
+	sockaddrunion* from, sockaddrunion* to, void* user_data)
+{
+	printf("socket read end sfd=%d,isudpsocket=%d,datalen=%d ... \n", sfd,
+		isudpsocket, datalen);
+	return 0;
+}
+int
+select_start(void* user_data)
+{
+	printf("select_start\n");
+	return 0;
+}
+int
+select_end(void* user_data)
+{
+	printf("select_end\n");
+	mulp_disable_mtra_select_handler();
+	return 0;
+}
+
+#include "wheel-timer.h"
+
+TEST(TRANSPORT_MODULE, test_process_stdin)
+{
+	int rcwnd = 512;
+	mtra_init(&rcwnd);
+
+	cbunion_t cbunion;
+	cbunion.socket_cb_fun = socket_cb;
+	mtra_set_expected_event_on_fd(mtra_read_ip4rawsock(),
+		EVENTCB_TYPE_SCTP,
+		POLLIN | POLLPRI, cbunion, 0);
+	mtra_set_expected_event_on_fd(mtra_read_ip4udpsock(),
+		EVENTCB_TYPE_UDP,
+		POLLIN | POLLPRI, cbunion, 0);
+	mtra_set_expected_event_on_fd(mtra_read_ip6rawsock(),
+		EVENTCB_TYPE_SCTP,
+		POLLIN | POLLPRI, cbunion, 0);
+	mtra_set_expected_event_on_fd(mtra_read_ip6udpsock(),
+		EVENTCB_TYPE_UDP,
+		POLLIN | POLLPRI, cbunion, 0);
+
+	//you have to put stdin as last because we test it
+	mtra_add_stdin_cb(stdin_cb);
+	//mtra_set_tick_task_cb (task_cb, (void*) "this is user datta");
+
+	timeout* tout = (timeout*)geco_malloc_ext(sizeof(timeout), __FILE__, __LINE__);
+	tout->callback.action = &wheel_timer_cb;
+	tout->callback.type = TIMER_TYPE_INIT;
+	tout->flags = TIMEOUT_INT;
+	timeouts_add(mtra_read_timeouts(), tout, 1800 * 1000 / WHEEL_TICK_MS);
+
+	socket_read_start_cb_t mtra_socket_read_start = socket_read_start;
+	socket_read_end_cb_t mtra_socket_read_end = socket_read_end;
+	mulp_set_socket_read_handler(mtra_socket_read_start, mtra_socket_read_end);
+	mulp_enable_socket_read_handler();
+
+	select_cb_t mtra_select_start = select_start;
+	select_cb_t mtra_select_end = select_end;
+	mulp_set_mtra_select_handler(mtra_select_start, mtra_select_end);
+	mulp_enable_mtra_select_handler();
+
+	while (flag)
+		mtra_poll();
+	mtra_destroy();
+}
+
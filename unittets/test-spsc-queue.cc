@@ -0,0 +1,230 @@
+/*
+ * test-spsc-queue.cc
+ *
+ *  single producer single consumer ring
+ */
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "geco-common.h"
+#include "spsc-queue.h"
+#include "mpsc-queue.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using geco::ds::spsc_queue_t;
+
+/// keeps the calling thread on @cpu so the two sides of a benchmark run on two cores
+static void pin_to_cpu(unsigned int cpu)
+{
+#ifdef __linux__
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(cpu % std::max(1u, std::thread::hardware_concurrency()), &set);
+	pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#elif defined(_WIN32)
+	SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR) 1 << cpu);
+#endif
+}
+
+TEST(SPSC_QUEUE_MODULE, test_full_empty_and_wrap)
+{
+	spsc_queue_t<uint, 100> q;
+	EXPECT_EQ(q.CAPACITY, 128u);
+	EXPECT_TRUE(q.IsEmpty());
+	uint v;
+	EXPECT_FALSE(q.try_pop(v));
+
+	for (uint i = 0; i < q.CAPACITY; i++)
+		EXPECT_TRUE(q.try_push(i));
+	EXPECT_FALSE(q.try_push(1000));
+	EXPECT_EQ(q.Size(), q.CAPACITY);
+	EXPECT_EQ(q[5], 5u);
+	for (uint i = 0; i < q.CAPACITY; i++)
+	{
+		EXPECT_TRUE(q.try_pop(v));
+		EXPECT_EQ(v, i);
+	}
+	EXPECT_FALSE(q.try_pop(v));
+	EXPECT_TRUE(q.IsEmpty());
+
+	// bulk calls move what fits across the end of the buffer and the wrap of the indices
+	uint in[200], out[200];
+	uint pushed = 0, popped = 0;
+	for (int round = 0; round < 1000; round++)
+	{
+		uint want = 1 + round % 90;
+		for (uint i = 0; i < want; i++)
+			in[i] = pushed + i;
+		pushed += q.push_bulk(in, want);
+		uint n = q.pop_bulk(out, 1 + round % 70);
+		for (uint i = 0; i < n; i++)
+			EXPECT_EQ(out[i], popped + i);
+		popped += n;
+		EXPECT_EQ(q.Size(), pushed - popped);
+	}
+	EXPECT_EQ(q.push_bulk(in, 200), q.CAPACITY - (pushed - popped));
+	q.Clear();
+	EXPECT_TRUE(q.IsEmpty());
+	EXPECT_EQ(q.pop_bulk(out, 10), 0u);
+}
+
+TEST(SPSC_QUEUE_MODULE, test_two_threads_throughput_and_latency)
+{
+	const uint64 count = 10000000;
+	const uint batch = 32;
+	typedef spsc_queue_t<uint64, 4096> queue_t;
+
+	for (int bulk = 0; bulk < 2; bulk++)
+	{
+		queue_t* q = new queue_t;
+		bool ordered = true;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		std::thread consumer([&]()
+		{
+			pin_to_cpu(1);
+			uint64 expect = 0;
+			uint64 buf[batch];
+			while (expect < count)
+			{
+				if (bulk)
+				{
+					uint n = q->pop_bulk(buf, batch);
+					for (uint i = 0; i < n; i++)
+						ordered &= buf[i] == expect++;
+					if (n == 0)
+						std::this_thread::yield();
+				}
+				else
+				{
+					uint64 v;
+					if (q->try_pop(v))
+						ordered &= v == expect++;
+					else
+						std::this_thread::yield();
+				}
+			}
+		});
+		pin_to_cpu(0);
+		uint64 buf[batch];
+		for (uint64 next = 0; next < count;)
+		{
+			if (bulk)
+			{
+				uint n = (uint) std::min<uint64>(batch, count - next);
+				for (uint i = 0; i < n; i++)
+					buf[i] = next + i;
+				n = q->push_bulk(buf, n);
+				next += n;
+				if (n == 0)
+					std::this_thread::yield();
+			}
+			else if (q->try_push(next))
+				next++;
+			else
+				std::this_thread::yield();
+		}
+		consumer.join();
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+		long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+		EXPECT_TRUE(ordered);
+		EXPECT_TRUE(q->IsEmpty());
+		std::cout << (bulk ? "push_bulk/pop_bulk of 32: " : "try_push/try_pop: ") << count * 1000 / ns
+			<< " M elements/s, " << (double) ns / count << "ns per element.\n";
+		delete q;
+	}
+
+	// one element bounced between the two threads, half a round trip is the latency.
+	// both sides spin, which only makes sense with a core each
+	if (std::thread::hardware_concurrency() < 2)
+		return;
+	const int trips = 100000;
+	queue_t* ping = new queue_t;
+	queue_t* pong = new queue_t;
+	std::thread echo([&]()
+	{
+		pin_to_cpu(1);
+		uint64 v;
+		for (int i = 0; i < trips; i++)
+		{
+			while (!ping->try_pop(v))
+				;
+			while (!pong->try_push(v))
+				;
+		}
+	});
+	pin_to_cpu(0);
+	std::vector<long long> rtt(trips);
+	for (int i = 0; i < trips; i++)
+	{
+		uint64 v;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		while (!ping->try_push(i))
+			;
+		while (!pong->try_pop(v))
+			;
+		rtt[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+		EXPECT_EQ(v, (uint64) i);
+	}
+	echo.join();
+	std::sort(rtt.begin(), rtt.end());
+	std::cout << "one way latency: median " << rtt[trips / 2] / 2 << "ns, 99% " << rtt[trips * 99 / 100] / 2 << "ns.\n";
+	delete ping;
+	delete pong;
+}
+
+TEST(MPSC_QUEUE_MODULE, test_producers_keep_their_order)
+{
+	typedef geco::ds::mpsc_queue_t<uint, 64> queue_t;
+	queue_t* q = new queue_t;
+	uint v;
+	EXPECT_TRUE(q->IsEmpty());
+	EXPECT_FALSE(q->try_pop(v));
+	for (uint i = 0; i < q->CAPACITY; i++)
+		EXPECT_TRUE(q->try_push(i));
+	EXPECT_FALSE(q->try_push(1000));
+	EXPECT_EQ(q->pop_bulk(&v, 1), 1u);
+	EXPECT_EQ(v, 0u);
+	EXPECT_TRUE(q->try_push(1000));
+	uint out[64];
+	EXPECT_EQ(q->pop_bulk(out, 64), 64u);
+	EXPECT_EQ(out[62], 63u);
+	EXPECT_EQ(out[63], 1000u);
+	EXPECT_TRUE(q->IsEmpty());
+
+	// elements of one producer come out in the order it pushed them
+	const uint producers = 4;
+	const uint per_producer = 200000;
+	std::vector<std::thread> threads;
+	for (uint p = 0; p < producers; p++)
+		threads.push_back(std::thread([=]()
+		{
+			for (uint i = 0; i < per_producer; i++)
+				while (!q->try_push(p << 24 | i))
+					std::this_thread::yield();
+		}));
+	uint next[producers] = { 0 };
+	bool ordered = true;
+	for (uint popped = 0; popped < producers * per_producer;)
+	{
+		uint n = q->pop_bulk(out, 64);
+		for (uint i = 0; i < n; i++)
+			ordered &= (out[i] & 0xffffff) == next[out[i] >> 24]++;
+		popped += n;
+		if (n == 0)
+			std::this_thread::yield();
+	}
+	for (auto& t : threads)
+		t.join();
+	EXPECT_TRUE(ordered);
+	EXPECT_TRUE(q->IsEmpty());
+	delete q;
+}